@@ -0,0 +1,100 @@
+#ifndef RING_BUFFER_BENCH_HPP
+#define RING_BUFFER_BENCH_HPP
+
+#include <cstddef>
+
+#include <memory>
+
+#include "benchmark/benchmark.h"
+
+namespace Bench
+{
+
+/*!
+ * Bytes currently allocated through any CountingAllocator.
+ */
+inline std::size_t& allocatedBytes()
+{
+    static std::size_t bytes = 0;
+    return bytes;
+}
+
+/*!
+ * std::allocator that keeps allocatedBytes() up to date, used to report the
+ * memory held per element by each container.
+ */
+template <typename T>
+class CountingAllocator : public std::allocator<T>
+{
+public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef CountingAllocator<U> other;
+    };
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        allocatedBytes() += n * sizeof(T);
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T* pointer, std::size_t n)
+    {
+        allocatedBytes() -= n * sizeof(T);
+        std::allocator<T>::deallocate(pointer, n);
+    }
+};
+
+template <typename T, typename U>
+bool operator ==(const CountingAllocator<T>&, const CountingAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator !=(const CountingAllocator<T>&, const CountingAllocator<U>&)
+{
+    return false;
+}
+
+/*!
+ * Trivially copyable element of Size bytes.
+ */
+template <std::size_t Size>
+struct Payload
+{
+    unsigned char bytes[Size];
+};
+
+/*!
+ * Reports time_per_op, where each iteration performs opsPerIteration
+ * operations (elements visited, elements copied, ...).
+ */
+inline void setOpsPerIteration(benchmark::State& state, double opsPerIteration)
+{
+    state.counters["time_per_op"] = benchmark::Counter(opsPerIteration,
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/*!
+ * Reports bytes_per_element, the memory allocated through CountingAllocator
+ * divided by the number of elements held.
+ */
+inline void setBytesPerElement(benchmark::State& state, std::size_t bytes, std::size_t elements)
+{
+    state.counters["bytes_per_element"] = elements == 0 ? 0 : (double)bytes / elements;
+}
+
+} // namespace Bench
+
+#endif
@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <ctime>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+
+#include <RB/BlockingQueue.hpp>
+
+#include "Bench.hpp"
+
+using namespace Bench;
+
+namespace
+{
+
+/*!
+ * CPU time used so far by every thread of the process, in seconds.
+ */
+double processCpuSeconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+std::int64_t nowNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*!
+ * Reports cores, the CPU time used by the whole process divided by the wall
+ * time, so 2 means both threads were busy the whole time.
+ */
+void setCores(benchmark::State& state, double cpuSeconds, double wallSeconds)
+{
+    state.counters["cores"] = wallSeconds == 0 ? 0 : cpuSeconds / wallSeconds;
+}
+
+/*
+ * A message goes back and forth between two threads over two queues, and
+ * each side blocks until the other answers, so every hand off wakes a waiter.
+ */
+template <typename WaitStrategy>
+void BM_PingPong(benchmark::State& state)
+{
+    RB::BlockingQueue<std::int64_t, WaitStrategy> ping(1);
+    RB::BlockingQueue<std::int64_t, WaitStrategy> pong(1);
+
+    std::thread echo([&ping, &pong] () {
+        std::int64_t value = 0;
+        do
+        {
+            ping.pop_wait(value);
+            pong.push_wait(value);
+        }
+        while(value >= 0);
+    });
+
+    std::int64_t value = 0;
+    const double cpuStart = processCpuSeconds();
+    const auto wallStart = std::chrono::steady_clock::now();
+    for(auto _ : state)
+    {
+        ping.push_wait(value);
+        pong.pop_wait(value);
+    }
+    const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+    const double cpu = processCpuSeconds() - cpuStart;
+
+    ping.push_wait(-1);
+    pong.pop_wait(value);
+    echo.join();
+
+    // two hand offs per round trip
+    setOpsPerIteration(state, 2);
+    setCores(state, cpu, wall.count());
+}
+
+/*
+ * The producer sends a timestamp, then idles for the range in microseconds,
+ * so the consumer is asleep (or spinning) when the next one arrives.
+ * wakeup_latency is the time from the push to the consumer holding the
+ * element, and cores shows what the waiting consumer costs while idle.
+ */
+template <typename WaitStrategy>
+void BM_SparseWakeup(benchmark::State& state)
+{
+    const auto idle = std::chrono::microseconds(state.range(0));
+    RB::BlockingQueue<std::int64_t, WaitStrategy> queue(16);
+    std::atomic<std::int64_t> totalLatency(0);
+
+    std::thread consumer([&queue, &totalLatency] () {
+        std::int64_t sent = 0;
+        for(;;)
+        {
+            queue.pop_wait(sent);
+            if(sent == std::numeric_limits<std::int64_t>::max())
+            {
+                break;
+            }
+            totalLatency.fetch_add(nowNanoseconds() - sent, std::memory_order_relaxed);
+        }
+    });
+
+    const double cpuStart = processCpuSeconds();
+    const auto wallStart = std::chrono::steady_clock::now();
+    for(auto _ : state)
+    {
+        queue.push_wait(nowNanoseconds());
+        std::this_thread::sleep_for(idle);
+    }
+    const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+    const double cpu = processCpuSeconds() - cpuStart;
+
+    queue.push_wait(std::numeric_limits<std::int64_t>::max());
+    consumer.join();
+
+    state.counters["wakeup_latency"] = benchmark::Counter(totalLatency.load() * 1e-9,
+        benchmark::Counter::kAvgIterations);
+    setCores(state, cpu, wall.count());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_PingPong, RB::BusySpinWait)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PingPong, RB::SpinYieldWait)->UseRealTime();
+#ifdef __linux__
+BENCHMARK_TEMPLATE(BM_PingPong, RB::FutexWait)->UseRealTime();
+#endif
+BENCHMARK_TEMPLATE(BM_PingPong, RB::ConditionVariableWait)->UseRealTime();
+
+// a fixed number of messages, most of the time is spent idle
+#define IDLE_TIMES Arg(50)->Arg(1000)->Iterations(1000)->UseRealTime()
+
+BENCHMARK_TEMPLATE(BM_SparseWakeup, RB::BusySpinWait)->IDLE_TIMES;
+BENCHMARK_TEMPLATE(BM_SparseWakeup, RB::SpinYieldWait)->IDLE_TIMES;
+#ifdef __linux__
+BENCHMARK_TEMPLATE(BM_SparseWakeup, RB::FutexWait)->IDLE_TIMES;
+#endif
+BENCHMARK_TEMPLATE(BM_SparseWakeup, RB::ConditionVariableWait)->IDLE_TIMES;
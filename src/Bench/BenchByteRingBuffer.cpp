@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include <RB/RingBuffer.hpp>
+#include <RB/ByteRingBuffer.hpp>
+
+#include "Bench.hpp"
+
+namespace
+{
+
+/*!
+ * Room for a few chunks plus an odd amount, so the chunks keep landing at
+ * different offsets and regularly straddle the end of the storage.
+ */
+std::size_t capacityFor(std::size_t chunk)
+{
+    return 4 * chunk + 61;
+}
+
+/*!
+ * The bound: copying each chunk into a buffer and back out, without a ring.
+ */
+void BM_Memcpy(benchmark::State& state)
+{
+    const std::size_t chunk = state.range(0);
+    std::vector<unsigned char> in(chunk, 1);
+    std::vector<unsigned char> out(chunk);
+    std::vector<unsigned char> buffer(capacityFor(chunk));
+
+    for(auto _ : state)
+    {
+        std::memcpy(buffer.data(), in.data(), chunk);
+        benchmark::ClobberMemory();
+        std::memcpy(out.data(), buffer.data(), chunk);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * chunk);
+}
+
+void BM_ByteRingBuffer(benchmark::State& state)
+{
+    const std::size_t chunk = state.range(0);
+    std::vector<unsigned char> in(chunk, 1);
+    std::vector<unsigned char> out(chunk);
+    RB::ByteRingBuffer ring(capacityFor(chunk));
+    // keep some bytes in, so the ring is never drained back to the front
+    ring.write(in.data(), 3);
+
+    for(auto _ : state)
+    {
+        ring.write(in.data(), chunk);
+        benchmark::ClobberMemory();
+        ring.read(out.data(), chunk);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * chunk);
+}
+
+/*!
+ * What ByteRingBuffer replaces: one push() and one pop() per byte.
+ */
+void BM_RingBufferPerByte(benchmark::State& state)
+{
+    const std::size_t chunk = state.range(0);
+    std::vector<unsigned char> in(chunk, 1);
+    std::vector<unsigned char> out(chunk);
+    RB::RingBuffer<std::uint8_t> ring(capacityFor(chunk));
+    for(std::size_t i = 0; i < 3; ++i)
+    {
+        ring.push(0);
+    }
+
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < chunk; ++i)
+        {
+            ring.push(in[i]);
+        }
+        benchmark::ClobberMemory();
+        for(std::size_t i = 0; i < chunk; ++i)
+        {
+            out[i] = ring.top();
+            ring.pop();
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * chunk);
+}
+
+} // namespace
+
+// an Ethernet payload and a large socket read
+#define BYTE_CHUNKS Arg(1500)->Arg(64 << 10)
+
+BENCHMARK(BM_Memcpy)->BYTE_CHUNKS;
+BENCHMARK(BM_ByteRingBuffer)->BYTE_CHUNKS;
+BENCHMARK(BM_RingBufferPerByte)->BYTE_CHUNKS;
@@ -0,0 +1,194 @@
+#include <cstdint>
+#include <cstddef>
+
+#include <algorithm>
+#include <numeric>
+
+#include "benchmark/benchmark.h"
+
+#include <RB/Reduce.hpp>
+
+#include "Bench.hpp"
+
+using namespace Bench;
+
+namespace
+{
+
+/*!
+ * A RingBuffer of n values whose elements wrap around the end of the
+ * storage, so both runs are used.
+ */
+template <typename T>
+RB::RingBuffer<T> makeWrapped(std::size_t n)
+{
+    RB::RingBuffer<T> container(n);
+    for(std::size_t i = 0; i < n / 2; ++i)
+    {
+        container.push(T());
+    }
+    container.discard(n / 2);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        container.push(static_cast<T>(i % 1000) - static_cast<T>(500));
+    }
+    return container;
+}
+
+/*!
+ * Sets the SimdLevel from the second range for the duration of a benchmark.
+ */
+class ScopedSimdLevel
+{
+public:
+    explicit ScopedSimdLevel(const benchmark::State& state) :
+    previous(RB::setSimdLevel(static_cast<RB::SimdLevel>(state.range(1))))
+    {
+    }
+
+    ~ScopedSimdLevel()
+    {
+        RB::setSimdLevel(previous);
+    }
+
+private:
+    RB::SimdLevel previous;
+};
+
+template <typename T>
+void BM_Accumulate(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    const RB::RingBuffer<T> container = makeWrapped<T>(n);
+
+    for(auto _ : state)
+    {
+        typename RB::ReduceTraits<T>::sum_type sum = std::accumulate(container.begin(), container.end(),
+            typename RB::ReduceTraits<T>::sum_type());
+        benchmark::DoNotOptimize(sum);
+    }
+
+    setOpsPerIteration(state, n);
+}
+
+template <typename T>
+void BM_Sum(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    const RB::RingBuffer<T> container = makeWrapped<T>(n);
+    ScopedSimdLevel level(state);
+
+    for(auto _ : state)
+    {
+        typename RB::ReduceTraits<T>::sum_type sum = RB::sum(container);
+        benchmark::DoNotOptimize(sum);
+    }
+
+    setOpsPerIteration(state, n);
+}
+
+template <typename T>
+void BM_MinElement(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    const RB::RingBuffer<T> container = makeWrapped<T>(n);
+
+    for(auto _ : state)
+    {
+        T minimum = *std::min_element(container.begin(), container.end());
+        benchmark::DoNotOptimize(minimum);
+    }
+
+    setOpsPerIteration(state, n);
+}
+
+template <typename T>
+void BM_Minimum(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    const RB::RingBuffer<T> container = makeWrapped<T>(n);
+    ScopedSimdLevel level(state);
+
+    for(auto _ : state)
+    {
+        T minimum = RB::minimum(container);
+        benchmark::DoNotOptimize(minimum);
+    }
+
+    setOpsPerIteration(state, n);
+}
+
+template <typename T>
+void BM_InnerProduct(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    const RB::RingBuffer<T> a = makeWrapped<T>(n);
+    const RB::RingBuffer<T> b = makeWrapped<T>(n);
+
+    for(auto _ : state)
+    {
+        typename RB::ReduceTraits<T>::sum_type dot = std::inner_product(a.begin(), a.end(), b.begin(),
+            typename RB::ReduceTraits<T>::sum_type());
+        benchmark::DoNotOptimize(dot);
+    }
+
+    setOpsPerIteration(state, n);
+}
+
+template <typename T>
+void BM_Dot(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    const RB::RingBuffer<T> a = makeWrapped<T>(n);
+    const RB::RingBuffer<T> b = makeWrapped<T>(n);
+    ScopedSimdLevel level(state);
+
+    for(auto _ : state)
+    {
+        typename RB::ReduceTraits<T>::sum_type dot = RB::dot(a, b);
+        benchmark::DoNotOptimize(dot);
+    }
+
+    setOpsPerIteration(state, n);
+}
+
+template <typename T>
+void BM_Variance(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    const RB::RingBuffer<T> container = makeWrapped<T>(n);
+    ScopedSimdLevel level(state);
+
+    for(auto _ : state)
+    {
+        typename RB::ReduceTraits<T>::real_type variance = RB::variance(container);
+        benchmark::DoNotOptimize(variance);
+    }
+
+    setOpsPerIteration(state, n);
+}
+
+} // namespace
+
+// 1024 and 65536 elements
+#define REDUCE_SIZES Arg(1 << 10)->Arg(1 << 16)
+// the same sizes at each SimdLevel, 0 is Scalar, 1 Vector128, 2 Vector256
+#define REDUCE_LEVELS ArgsProduct({{1 << 10, 1 << 16}, {0, 1, 2}})->ArgNames({"n", "level"})
+
+BENCHMARK_TEMPLATE(BM_Accumulate, float)->REDUCE_SIZES;
+BENCHMARK_TEMPLATE(BM_Sum, float)->REDUCE_LEVELS;
+BENCHMARK_TEMPLATE(BM_Accumulate, std::int32_t)->REDUCE_SIZES;
+BENCHMARK_TEMPLATE(BM_Sum, std::int32_t)->REDUCE_LEVELS;
+
+BENCHMARK_TEMPLATE(BM_MinElement, float)->REDUCE_SIZES;
+BENCHMARK_TEMPLATE(BM_Minimum, float)->REDUCE_LEVELS;
+BENCHMARK_TEMPLATE(BM_MinElement, std::int32_t)->REDUCE_SIZES;
+BENCHMARK_TEMPLATE(BM_Minimum, std::int32_t)->REDUCE_LEVELS;
+
+BENCHMARK_TEMPLATE(BM_InnerProduct, float)->REDUCE_SIZES;
+BENCHMARK_TEMPLATE(BM_Dot, float)->REDUCE_LEVELS;
+BENCHMARK_TEMPLATE(BM_InnerProduct, std::int32_t)->REDUCE_SIZES;
+BENCHMARK_TEMPLATE(BM_Dot, std::int32_t)->REDUCE_LEVELS;
+
+BENCHMARK_TEMPLATE(BM_Variance, float)->REDUCE_LEVELS;
+BENCHMARK_TEMPLATE(BM_Variance, std::int32_t)->REDUCE_LEVELS;
@@ -0,0 +1,396 @@
+#include <cstdint>
+#include <cstddef>
+
+#include <deque>
+#include <queue>
+#include <vector>
+#include <random>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include <RB/RingBuffer.hpp>
+
+#include "Bench.hpp"
+
+using namespace Bench;
+
+namespace
+{
+
+template <typename T>
+using RingBufferOf = RB::RingBuffer<T, CountingAllocator<T>>;
+
+template <typename T>
+using DequeOf = std::deque<T, CountingAllocator<T>>;
+
+template <typename T>
+using QueueOf = std::queue<T, DequeOf<T>>;
+
+template <typename T>
+using VectorOf = std::vector<T, CountingAllocator<T>>;
+
+// the RingBuffer is constructed with the capacity, the others grow
+template <typename Container>
+struct Make
+{
+    static Container create(std::size_t)
+    {
+        return Container();
+    }
+};
+
+template <typename T>
+struct Make<RingBufferOf<T>>
+{
+    static RingBufferOf<T> create(std::size_t capacity)
+    {
+        return RingBufferOf<T>(capacity);
+    }
+};
+
+// uniform push back / pop front over the compared containers
+template <typename T>
+void popFront(RingBufferOf<T>& container)
+{
+    container.pop();
+}
+
+template <typename T>
+void popFront(DequeOf<T>& container)
+{
+    container.pop_front();
+}
+
+template <typename T>
+void popFront(QueueOf<T>& container)
+{
+    container.pop();
+}
+
+template <typename T>
+void pushBack(RingBufferOf<T>& container, const T& value)
+{
+    container.push(value);
+}
+
+template <typename T>
+void pushBack(DequeOf<T>& container, const T& value)
+{
+    container.push_back(value);
+}
+
+template <typename T>
+void pushBack(QueueOf<T>& container, const T& value)
+{
+    container.push(value);
+}
+
+template <typename T>
+void pushBack(VectorOf<T>& container, const T& value)
+{
+    container.push_back(value);
+}
+
+template <typename Container>
+void enableGrowth(Container&)
+{
+}
+
+template <typename T>
+void enableGrowth(RingBufferOf<T>& container)
+{
+    container.setGrowthPolicy();
+}
+
+/*!
+ * Returns a container holding n elements. The RingBuffer has a capacity of n
+ * and its elements wrap around the end of the storage.
+ */
+template <typename Container, typename T>
+Container makeFilled(std::size_t n)
+{
+    Container container = Make<Container>::create(n);
+    for(std::size_t i = 0; i < n / 2; ++i)
+    {
+        pushBack(container, T());
+        popFront(container);
+    }
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        pushBack(container, T());
+    }
+    return container;
+}
+
+template <typename Container, typename T>
+void BM_PushPop(benchmark::State& state)
+{
+    const std::size_t capacity = state.range(0);
+    Container container = Make<Container>::create(capacity);
+    for(std::size_t i = 0; i < capacity / 2; ++i)
+    {
+        pushBack(container, T());
+    }
+
+    const T value = T();
+    for(auto _ : state)
+    {
+        pushBack(container, value);
+        popFront(container);
+        benchmark::ClobberMemory();
+    }
+
+    setOpsPerIteration(state, 1);
+    setBytesPerElement(state, allocatedBytes(), capacity / 2);
+}
+
+template <typename Container, typename T>
+void BM_GrowingPush(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    std::size_t held = 0;
+    const T value = T();
+    for(auto _ : state)
+    {
+        // every container starts empty, growth is part of the cost
+        Container container = Make<Container>::create(0);
+        enableGrowth(container);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            pushBack(container, value);
+        }
+        held = allocatedBytes();
+        benchmark::DoNotOptimize(container);
+    }
+
+    setOpsPerIteration(state, n);
+    setBytesPerElement(state, held, n);
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    Container container = makeFilled<Container, int>(n);
+    int value = 0;
+    for(int& element : container)
+    {
+        element = value++;
+    }
+
+    for(auto _ : state)
+    {
+        int sum = 0;
+        for(const int& element : container)
+        {
+            sum += element;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    setOpsPerIteration(state, n);
+}
+
+template <typename Container>
+void BM_RandomAccess(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    Container container = makeFilled<Container, int>(n);
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> distribution(0, n - 1);
+    std::vector<std::size_t> indices(4096);
+    for(std::size_t& index : indices)
+    {
+        index = distribution(generator);
+    }
+
+    for(auto _ : state)
+    {
+        int sum = 0;
+        for(std::size_t index : indices)
+        {
+            sum += container[index];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    setOpsPerIteration(state, indices.size());
+}
+
+template <typename T>
+void BM_ChangeCapacity(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    RingBufferOf<T> container = makeFilled<RingBufferOf<T>, T>(n);
+
+    for(auto _ : state)
+    {
+        container.changeCapacity(2 * n);
+        container.changeCapacity(n);
+    }
+
+    // each element is moved twice per iteration
+    setOpsPerIteration(state, 2 * n);
+}
+
+template <typename T>
+void BM_ChangeSize_RingBuffer(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    RingBufferOf<T> container = makeFilled<RingBufferOf<T>, T>(n);
+
+    for(auto _ : state)
+    {
+        container.changeSize(n / 2);
+        container.changeSize(n);
+    }
+
+    // n / 2 elements are removed and added back per iteration
+    setOpsPerIteration(state, n);
+}
+
+template <typename T>
+void BM_ChangeSize_Deque(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    DequeOf<T> container = makeFilled<DequeOf<T>, T>(n);
+
+    for(auto _ : state)
+    {
+        container.resize(n / 2);
+        container.resize(n);
+    }
+
+    setOpsPerIteration(state, n);
+}
+
+template <typename Container, typename T>
+void BM_CopyConstruct(benchmark::State& state)
+{
+    const std::size_t n = state.range(0);
+    Container container = makeFilled<Container, T>(n);
+    const std::size_t held = allocatedBytes();
+
+    for(auto _ : state)
+    {
+        Container copy(container);
+        benchmark::DoNotOptimize(copy);
+    }
+
+    setOpsPerIteration(state, n);
+    setBytesPerElement(state, held, n);
+}
+
+/*!
+ * A RingBuffer of twice the chunk size holding half a chunk, so chunks pushed
+ * and popped through it keep straddling the end of the storage.
+ */
+template <typename T>
+RingBufferOf<T> makeChunkRing(std::size_t chunk)
+{
+    RingBufferOf<T> container(2 * chunk);
+    for(std::size_t i = 0; i < chunk / 2; ++i)
+    {
+        container.push(T());
+    }
+    return container;
+}
+
+/*
+ * Moves a chunk in with push(first, last) and out with pop_into, two
+ * contiguous runs (memcpy for trivially copyable T) each way.
+ */
+template <typename T>
+void BM_BulkPushPop(benchmark::State& state)
+{
+    const std::size_t chunk = state.range(0);
+    RingBufferOf<T> container = makeChunkRing<T>(chunk);
+    const std::vector<T> in(chunk);
+    std::vector<T> out(chunk);
+
+    for(auto _ : state)
+    {
+        container.push(in.data(), in.data() + chunk);
+        container.pop_into(out.data(), chunk);
+        benchmark::ClobberMemory();
+    }
+
+    setOpsPerIteration(state, chunk);
+}
+
+/*
+ * The same chunk through push, top and pop, one element at a time.
+ */
+template <typename T>
+void BM_PerElementPushPop(benchmark::State& state)
+{
+    const std::size_t chunk = state.range(0);
+    RingBufferOf<T> container = makeChunkRing<T>(chunk);
+    const std::vector<T> in(chunk);
+    std::vector<T> out(chunk);
+
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < chunk; ++i)
+        {
+            container.push(in[i]);
+        }
+        for(std::size_t i = 0; i < chunk; ++i)
+        {
+            out[i] = container.top();
+            container.pop();
+        }
+        benchmark::ClobberMemory();
+    }
+
+    setOpsPerIteration(state, chunk);
+}
+
+} // namespace
+
+// 16, 64, 4096 and 65536 elements
+#define CAPACITIES RangeMultiplier(64)->Range(16, 1 << 16)
+
+BENCHMARK_TEMPLATE(BM_PushPop, RingBufferOf<std::uint32_t>, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_PushPop, DequeOf<std::uint32_t>, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_PushPop, QueueOf<std::uint32_t>, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_PushPop, RingBufferOf<Payload<64>>, Payload<64>)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_PushPop, DequeOf<Payload<64>>, Payload<64>)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_PushPop, QueueOf<Payload<64>>, Payload<64>)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_PushPop, RingBufferOf<Payload<256>>, Payload<256>)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_PushPop, DequeOf<Payload<256>>, Payload<256>)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_PushPop, QueueOf<Payload<256>>, Payload<256>)->CAPACITIES;
+
+BENCHMARK_TEMPLATE(BM_GrowingPush, RingBufferOf<std::uint32_t>, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_GrowingPush, DequeOf<std::uint32_t>, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_GrowingPush, VectorOf<std::uint32_t>, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_GrowingPush, RingBufferOf<std::string>, std::string)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_GrowingPush, DequeOf<std::string>, std::string)->CAPACITIES;
+
+BENCHMARK_TEMPLATE(BM_Iterate, RingBufferOf<int>)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_Iterate, DequeOf<int>)->CAPACITIES;
+
+BENCHMARK_TEMPLATE(BM_RandomAccess, RingBufferOf<int>)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_RandomAccess, DequeOf<int>)->CAPACITIES;
+
+BENCHMARK_TEMPLATE(BM_ChangeCapacity, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_ChangeCapacity, Payload<64>)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_ChangeCapacity, std::string)->CAPACITIES;
+
+BENCHMARK_TEMPLATE(BM_ChangeSize_RingBuffer, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_ChangeSize_Deque, std::uint32_t)->CAPACITIES;
+
+BENCHMARK_TEMPLATE(BM_CopyConstruct, RingBufferOf<std::uint32_t>, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_CopyConstruct, DequeOf<std::uint32_t>, std::uint32_t)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_CopyConstruct, RingBufferOf<Payload<64>>, Payload<64>)->CAPACITIES;
+BENCHMARK_TEMPLATE(BM_CopyConstruct, DequeOf<Payload<64>>, Payload<64>)->CAPACITIES;
+
+// 4096 element chunks
+BENCHMARK_TEMPLATE(BM_BulkPushPop, std::uint8_t)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_PerElementPushPop, std::uint8_t)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_BulkPushPop, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_PerElementPushPop, float)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_BulkPushPop, Payload<64>)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_PerElementPushPop, Payload<64>)->Arg(4096);
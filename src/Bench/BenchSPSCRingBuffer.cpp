@@ -0,0 +1,91 @@
+#include <cstdint>
+
+#include <mutex>
+#include <thread>
+
+#include "benchmark/benchmark.h"
+
+#include <RB/RingBuffer.hpp>
+#include <RB/SPSCRingBuffer.hpp>
+
+#include "Bench.hpp"
+
+using namespace Bench;
+
+namespace
+{
+
+/*!
+ * A RingBuffer behind a std::mutex, what SPSCRingBuffer replaces.
+ */
+template <typename T>
+class LockedRingBuffer
+{
+public:
+    explicit LockedRingBuffer(std::size_t capacity) :
+    ringBuffer(capacity)
+    {
+    }
+
+    bool try_push(const T& value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ringBuffer.try_push(value);
+    }
+
+    bool try_pop(T& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ringBuffer.try_pop(out);
+    }
+
+private:
+    std::mutex mutex;
+    RB::RingBuffer<T> ringBuffer;
+};
+
+/*
+ * The benchmark thread pushes one element per iteration while a second
+ * thread pops them, both yielding while the queue is full or empty, so
+ * time_per_op is the cost of moving one element between the threads.
+ */
+template <typename Queue>
+void BM_Transfer(benchmark::State& state)
+{
+    Queue queue(1024);
+
+    std::thread consumer([&queue] () {
+        std::uint64_t value = 0;
+        do
+        {
+            while(!queue.try_pop(value))
+            {
+                std::this_thread::yield();
+            }
+        }
+        while(value != 0);
+    });
+
+    std::uint64_t value = 1;
+    for(auto _ : state)
+    {
+        while(!queue.try_push(value))
+        {
+            std::this_thread::yield();
+        }
+        ++value;
+    }
+
+    while(!queue.try_push(0))
+    {
+        std::this_thread::yield();
+    }
+    consumer.join();
+
+    setOpsPerIteration(state, 1);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_Transfer, LockedRingBuffer<std::uint64_t>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Transfer, RB::SPSCRingBuffer<std::uint64_t>)->UseRealTime();
@@ -0,0 +1,136 @@
+#ifndef BLOCKING_QUEUE_HPP
+#define BLOCKING_QUEUE_HPP
+
+#ifndef RING_BUFFER_DEFAULT_CAPACITY
+  #define RING_BUFFER_DEFAULT_CAPACITY 32
+#endif
+
+#ifndef RING_BUFFER_CACHE_LINE_SIZE
+  #define RING_BUFFER_CACHE_LINE_SIZE 64
+#endif
+
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include "RingBuffer.hpp"
+#include "WaitStrategy.hpp"
+
+namespace RB
+{
+
+/*!
+ * A bounded queue over a RingBuffer that may be shared between any number of
+ * producer and consumer threads, where push_wait blocks while the queue is
+ * full and pop_wait blocks while it is empty.
+ *
+ * How a blocked thread waits is chosen with WaitStrategy: BusySpinWait,
+ * SpinYieldWait, FutexWait (Linux only) or ConditionVariableWait (see
+ * WaitStrategy.hpp). The RingBuffer itself is guarded by a mutex that is
+ * never held while waiting.
+ *
+ * Waiting is done on an event count: a thread about to wait announces it in
+ * a counter, checks the queue one last time, then waits for the event's epoch
+ * to change. A push or pop only notifies the other side when that counter is
+ * not 0, so as long as nobody waits, the queue never makes a system call or
+ * touches the wait strategy.
+ *
+ * Like RingBuffer, the queue holds exactly "capacity" elements. With a
+ * capacity of 0 every push_wait blocks forever.
+ */
+template <typename T, typename WaitStrategy = ConditionVariableWait>
+class BlockingQueue
+{
+public:
+    typedef T value_type;
+    typedef WaitStrategy wait_strategy_type;
+
+    BlockingQueue(std::size_t capacity = RING_BUFFER_DEFAULT_CAPACITY);
+
+    // no copy or move, other threads may be using the queue
+    BlockingQueue(const BlockingQueue<T, WaitStrategy>& other) = delete;
+    BlockingQueue<T, WaitStrategy>& operator=(const BlockingQueue<T, WaitStrategy>& other) = delete;
+
+    /*!
+     * Push, blocking while the queue is full.
+     */
+    void push_wait(const T& reference);
+    void push_wait(T&& r_value);
+
+    /*!
+     * Same as push_wait, but gives up after timeout. Returns true if the
+     * element was pushed, a moved from r_value is left unchanged otherwise.
+     */
+    template <typename Rep, typename Period>
+    bool push_wait_for(const T& reference, const std::chrono::duration<Rep, Period>& timeout);
+    template <typename Rep, typename Period>
+    bool push_wait_for(T&& r_value, const std::chrono::duration<Rep, Period>& timeout);
+
+    /*!
+     * Moves the oldest element to out and pops it, blocking while the queue
+     * is empty.
+     */
+    void pop_wait(T& out);
+
+    /*!
+     * Same as pop_wait, but gives up after timeout. Returns false, leaving
+     * out unchanged, if the queue stayed empty.
+     */
+    template <typename Rep, typename Period>
+    bool pop_wait_for(T& out, const std::chrono::duration<Rep, Period>& timeout);
+
+    /*!
+     * Never block. Return false if the queue is full or empty.
+     */
+    bool try_push(const T& reference);
+    bool try_push(T&& r_value);
+    template <typename... Args>
+    bool try_emplace(Args&&... args);
+    bool try_pop(T& out);
+
+    /*!
+     * Only a snapshot when other threads are pushing or popping.
+     */
+    bool empty() const;
+    std::size_t getCapacity() const;
+    /*!
+     * Only a snapshot when other threads are pushing or popping.
+     */
+    std::size_t getSize() const;
+
+private:
+    struct alignas(RING_BUFFER_CACHE_LINE_SIZE) Event
+    {
+        std::atomic<std::uint32_t> epoch;
+        std::atomic<std::uint32_t> waiters;
+        WaitStrategy strategy;
+
+        Event();
+        void notify();
+    };
+
+    mutable std::mutex mutex;
+    RingBuffer<T> buffer;
+
+    // consumers wait on notEmpty, producers on notFull
+    Event notEmpty;
+    Event notFull;
+
+    /*!
+     * Calls attempt() until it returns true, waiting on event in between,
+     * until deadline if it is not null. Returns the last result of attempt().
+     */
+    template <typename Attempt>
+    bool waitFor(Event& event, const WaitDeadline* deadline, Attempt attempt);
+
+};
+
+} // namespace RB
+
+#include "BlockingQueue.inl"
+
+#endif
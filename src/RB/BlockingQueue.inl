@@ -0,0 +1,173 @@
+
+#include <utility>
+
+template <typename T, typename WaitStrategy>
+RB::BlockingQueue<T, WaitStrategy>::Event::Event() :
+epoch(0),
+waiters(0),
+strategy()
+{
+}
+
+template <typename T, typename WaitStrategy>
+void RB::BlockingQueue<T, WaitStrategy>::Event::notify()
+{
+    // the waiter's increment happened before it last locked the mutex, which
+    // the caller just released, so a waiter that missed the change is counted
+    if(waiters.load(std::memory_order_seq_cst) != 0)
+    {
+        strategy.notify(epoch);
+    }
+}
+
+template <typename T, typename WaitStrategy>
+RB::BlockingQueue<T, WaitStrategy>::BlockingQueue(std::size_t capacity) :
+mutex(),
+buffer(capacity),
+notEmpty(),
+notFull()
+{
+}
+
+template <typename T, typename WaitStrategy>
+void RB::BlockingQueue<T, WaitStrategy>::push_wait(const T& reference)
+{
+    waitFor(notFull, nullptr, [&] () { return try_push(reference); });
+}
+
+template <typename T, typename WaitStrategy>
+void RB::BlockingQueue<T, WaitStrategy>::push_wait(T&& r_value)
+{
+    waitFor(notFull, nullptr, [&] () { return try_push(std::move(r_value)); });
+}
+
+template <typename T, typename WaitStrategy>
+template <typename Rep, typename Period>
+bool RB::BlockingQueue<T, WaitStrategy>::push_wait_for(const T& reference, const std::chrono::duration<Rep, Period>& timeout)
+{
+    const WaitDeadline deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    return waitFor(notFull, &deadline, [&] () { return try_push(reference); });
+}
+
+template <typename T, typename WaitStrategy>
+template <typename Rep, typename Period>
+bool RB::BlockingQueue<T, WaitStrategy>::push_wait_for(T&& r_value, const std::chrono::duration<Rep, Period>& timeout)
+{
+    const WaitDeadline deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    return waitFor(notFull, &deadline, [&] () { return try_push(std::move(r_value)); });
+}
+
+template <typename T, typename WaitStrategy>
+void RB::BlockingQueue<T, WaitStrategy>::pop_wait(T& out)
+{
+    waitFor(notEmpty, nullptr, [&] () { return try_pop(out); });
+}
+
+template <typename T, typename WaitStrategy>
+template <typename Rep, typename Period>
+bool RB::BlockingQueue<T, WaitStrategy>::pop_wait_for(T& out, const std::chrono::duration<Rep, Period>& timeout)
+{
+    const WaitDeadline deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    return waitFor(notEmpty, &deadline, [&] () { return try_pop(out); });
+}
+
+template <typename T, typename WaitStrategy>
+bool RB::BlockingQueue<T, WaitStrategy>::try_push(const T& reference)
+{
+    return try_emplace(reference);
+}
+
+template <typename T, typename WaitStrategy>
+bool RB::BlockingQueue<T, WaitStrategy>::try_push(T&& r_value)
+{
+    return try_emplace(std::move(r_value));
+}
+
+template <typename T, typename WaitStrategy>
+template <typename... Args>
+bool RB::BlockingQueue<T, WaitStrategy>::try_emplace(Args&&... args)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!buffer.try_emplace(std::forward<Args>(args)...))
+        {
+            return false;
+        }
+    }
+    notEmpty.notify();
+    return true;
+}
+
+template <typename T, typename WaitStrategy>
+bool RB::BlockingQueue<T, WaitStrategy>::try_pop(T& out)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!buffer.try_pop(out))
+        {
+            return false;
+        }
+    }
+    notFull.notify();
+    return true;
+}
+
+template <typename T, typename WaitStrategy>
+bool RB::BlockingQueue<T, WaitStrategy>::empty() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return buffer.empty();
+}
+
+template <typename T, typename WaitStrategy>
+std::size_t RB::BlockingQueue<T, WaitStrategy>::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return buffer.getCapacity();
+}
+
+template <typename T, typename WaitStrategy>
+std::size_t RB::BlockingQueue<T, WaitStrategy>::getSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return buffer.getSize();
+}
+
+template <typename T, typename WaitStrategy>
+template <typename Attempt>
+bool RB::BlockingQueue<T, WaitStrategy>::waitFor(Event& event, const WaitDeadline* deadline, Attempt attempt)
+{
+    while(!attempt())
+    {
+        // announce the wait before the last check, so a change made after
+        // that check sees the waiter and bumps the epoch read here
+        event.waiters.fetch_add(1, std::memory_order_seq_cst);
+        const std::uint32_t key = event.epoch.load(std::memory_order_seq_cst);
+        if(attempt())
+        {
+            event.waiters.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool changed = true;
+        if(deadline)
+        {
+            changed = event.strategy.waitUntil(event.epoch, key, *deadline);
+        }
+        else
+        {
+            event.strategy.wait(event.epoch, key);
+        }
+        event.waiters.fetch_sub(1, std::memory_order_relaxed);
+
+        if(!changed)
+        {
+            // one last try, a notify may have raced with the timeout
+            return attempt();
+        }
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+#ifndef BYTE_RING_BUFFER_HPP
+#define BYTE_RING_BUFFER_HPP
+
+#ifndef RING_BUFFER_DEFAULT_CAPACITY
+  #define RING_BUFFER_DEFAULT_CAPACITY 32
+#endif
+
+#include <cstdlib>
+#include <cstddef>
+
+#include <memory>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <sys/types.h>
+#endif
+
+namespace RB
+{
+
+/*!
+ * A ring of bytes for buffering streams (socket payloads for example), which
+ * moves whole chunks in and out instead of one element per push() or pop().
+ *
+ * Every operation copies with at most two memcpy calls, one for the run up to
+ * the end of the storage and one for the run wrapping to its start. None of
+ * them fail when there is not enough data or room: they move as many bytes as
+ * they can and return that count, like read(2) and write(2) do.
+ */
+class ByteRingBuffer
+{
+public:
+    typedef unsigned char value_type;
+
+    ByteRingBuffer(std::size_t capacity = RING_BUFFER_DEFAULT_CAPACITY);
+    ~ByteRingBuffer() = default;
+
+    // copy
+    ByteRingBuffer(const ByteRingBuffer& other);
+    ByteRingBuffer& operator=(const ByteRingBuffer& other);
+
+    // move, the moved from ByteRingBuffer is left with a capacity of 0
+    ByteRingBuffer(ByteRingBuffer&& other) noexcept;
+    ByteRingBuffer& operator=(ByteRingBuffer&& other) noexcept;
+
+    void swap(ByteRingBuffer& other) noexcept;
+
+    /*!
+     * Appends up to n bytes from data, as many as there is room for, and
+     * returns how many were appended.
+     */
+    std::size_t write(const void* data, std::size_t n);
+
+    /*!
+     * Moves up to n of the oldest bytes into data and returns how many were
+     * moved.
+     */
+    std::size_t read(void* data, std::size_t n);
+
+    /*!
+     * Same as read(), but starts offset bytes after the oldest byte and leaves
+     * the bytes in the buffer. Returns 0 if offset is not less than getSize().
+     */
+    std::size_t peek(void* data, std::size_t n, std::size_t offset = 0) const;
+
+    /*!
+     * Drops up to n of the oldest bytes and returns how many were dropped.
+     */
+    std::size_t skip(std::size_t n);
+
+#if defined(__unix__) || defined(__APPLE__)
+    /*!
+     * Appends what a single readv(2) on fd returns, reading straight into
+     * the free space (both runs of it when it wraps) without an intermediate
+     * copy. Returns what readv returned: the number of bytes appended, 0 at
+     * end of file, or -1 with errno set (EAGAIN on an empty non blocking fd,
+     * EINTR, ...). If the buffer is full, returns -1 with errno set to
+     * ENOBUFS without reading, so 0 always means end of file.
+     */
+    ssize_t readFrom(int fd);
+
+    /*!
+     * Sends the bytes with a single writev(2) on fd and drops as many as it
+     * wrote. Returns what writev returned, the number of bytes sent or -1
+     * with errno set. Returns 0 without writing if the buffer is empty.
+     */
+    ssize_t writeTo(int fd);
+#endif
+
+    /*!
+     * Unchecked, index must be less than getSize().
+     */
+    unsigned char& operator [](std::size_t index);
+    const unsigned char& operator [](std::size_t index) const;
+
+    bool empty() const;
+    bool full() const;
+    std::size_t getCapacity() const;
+    std::size_t getSize() const;
+
+    /*!
+     * getCapacity() - getSize(), the most a write() can append.
+     */
+    std::size_t getFreeSize() const;
+
+    void clear();
+
+private:
+    std::unique_ptr<unsigned char[]> buffer;
+    std::size_t bufferSize;
+    std::size_t r;
+    std::size_t size;
+
+    std::size_t wrapIndex(std::size_t index) const;
+
+};
+
+} // namespace RB
+
+#include "ByteRingBuffer.inl"
+
+#endif
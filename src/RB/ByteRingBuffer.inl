@@ -0,0 +1,222 @@
+#include <cstring>
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <cerrno>
+
+  #include <sys/uio.h>
+#endif
+
+inline RB::ByteRingBuffer::ByteRingBuffer(std::size_t capacity) :
+buffer(capacity == 0 ? nullptr : new unsigned char[capacity]),
+bufferSize(capacity),
+r(0),
+size(0)
+{
+}
+
+inline RB::ByteRingBuffer::ByteRingBuffer(const RB::ByteRingBuffer& other) :
+buffer(other.bufferSize == 0 ? nullptr : new unsigned char[other.bufferSize]),
+bufferSize(other.bufferSize),
+r(0),
+size(0)
+{
+    // packs the bytes at the start of the copy
+    size = other.peek(buffer.get(), other.size);
+}
+
+inline RB::ByteRingBuffer& RB::ByteRingBuffer::operator=(const RB::ByteRingBuffer& other)
+{
+    if(this != &other)
+    {
+        ByteRingBuffer copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+inline RB::ByteRingBuffer::ByteRingBuffer(RB::ByteRingBuffer&& other) noexcept :
+buffer(std::move(other.buffer)),
+bufferSize(other.bufferSize),
+r(other.r),
+size(other.size)
+{
+    other.bufferSize = 0;
+    other.r = 0;
+    other.size = 0;
+}
+
+inline RB::ByteRingBuffer& RB::ByteRingBuffer::operator=(RB::ByteRingBuffer&& other) noexcept
+{
+    if(this != &other)
+    {
+        ByteRingBuffer moved(std::move(other));
+        swap(moved);
+    }
+    return *this;
+}
+
+inline void RB::ByteRingBuffer::swap(RB::ByteRingBuffer& other) noexcept
+{
+    using std::swap;
+    swap(buffer, other.buffer);
+    swap(bufferSize, other.bufferSize);
+    swap(r, other.r);
+    swap(size, other.size);
+}
+
+inline std::size_t RB::ByteRingBuffer::write(const void* data, std::size_t n)
+{
+    n = std::min(n, bufferSize - size);
+    if(n == 0)
+    {
+        return 0;
+    }
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    const std::size_t w = wrapIndex(r + size);
+    const std::size_t first = std::min(n, bufferSize - w);
+    std::memcpy(buffer.get() + w, bytes, first);
+    if(first < n)
+    {
+        std::memcpy(buffer.get(), bytes + first, n - first);
+    }
+    size += n;
+    return n;
+}
+
+inline std::size_t RB::ByteRingBuffer::read(void* data, std::size_t n)
+{
+    return skip(peek(data, n));
+}
+
+inline std::size_t RB::ByteRingBuffer::peek(void* data, std::size_t n, std::size_t offset) const
+{
+    if(offset >= size)
+    {
+        return 0;
+    }
+    n = std::min(n, size - offset);
+    if(n == 0)
+    {
+        return 0;
+    }
+
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    const std::size_t start = wrapIndex(r + offset);
+    const std::size_t first = std::min(n, bufferSize - start);
+    std::memcpy(bytes, buffer.get() + start, first);
+    if(first < n)
+    {
+        std::memcpy(bytes + first, buffer.get(), n - first);
+    }
+    return n;
+}
+
+inline std::size_t RB::ByteRingBuffer::skip(std::size_t n)
+{
+    n = std::min(n, size);
+    size -= n;
+    // once drained, restart at the front so the next write is a single run
+    r = size == 0 ? 0 : wrapIndex(r + n);
+    return n;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+inline ssize_t RB::ByteRingBuffer::readFrom(int fd)
+{
+    if(size == bufferSize)
+    {
+        errno = ENOBUFS;
+        return -1;
+    }
+
+    // the free space from w to the end of the storage, then up to r
+    const std::size_t w = wrapIndex(r + size);
+    const std::size_t first = std::min(bufferSize - size, bufferSize - w);
+    iovec segments[2];
+    segments[0].iov_base = buffer.get() + w;
+    segments[0].iov_len = first;
+    segments[1].iov_base = buffer.get();
+    segments[1].iov_len = bufferSize - size - first;
+
+    const ssize_t count = readv(fd, segments, segments[1].iov_len == 0 ? 1 : 2);
+    if(count > 0)
+    {
+        size += static_cast<std::size_t>(count);
+    }
+    return count;
+}
+
+inline ssize_t RB::ByteRingBuffer::writeTo(int fd)
+{
+    if(size == 0)
+    {
+        return 0;
+    }
+
+    // the bytes from r to the end of the storage, then the wrapped ones
+    const std::size_t first = std::min(size, bufferSize - r);
+    iovec segments[2];
+    segments[0].iov_base = buffer.get() + r;
+    segments[0].iov_len = first;
+    segments[1].iov_base = buffer.get();
+    segments[1].iov_len = size - first;
+
+    const ssize_t count = writev(fd, segments, segments[1].iov_len == 0 ? 1 : 2);
+    if(count > 0)
+    {
+        skip(static_cast<std::size_t>(count));
+    }
+    return count;
+}
+#endif
+
+inline unsigned char& RB::ByteRingBuffer::operator [](std::size_t index)
+{
+    return buffer[wrapIndex(r + index)];
+}
+
+inline const unsigned char& RB::ByteRingBuffer::operator [](std::size_t index) const
+{
+    return buffer[wrapIndex(r + index)];
+}
+
+inline bool RB::ByteRingBuffer::empty() const
+{
+    return size == 0;
+}
+
+inline bool RB::ByteRingBuffer::full() const
+{
+    return size == bufferSize;
+}
+
+inline std::size_t RB::ByteRingBuffer::getCapacity() const
+{
+    return bufferSize;
+}
+
+inline std::size_t RB::ByteRingBuffer::getSize() const
+{
+    return size;
+}
+
+inline std::size_t RB::ByteRingBuffer::getFreeSize() const
+{
+    return bufferSize - size;
+}
+
+inline void RB::ByteRingBuffer::clear()
+{
+    r = 0;
+    size = 0;
+}
+
+inline std::size_t RB::ByteRingBuffer::wrapIndex(std::size_t index) const
+{
+    // callers pass less than 2 * bufferSize, so one subtraction is enough
+    return index >= bufferSize ? index - bufferSize : index;
+}
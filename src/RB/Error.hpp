@@ -0,0 +1,55 @@
+#ifndef RING_BUFFER_ERROR_HPP
+#define RING_BUFFER_ERROR_HPP
+
+#include <cstdio>
+#include <cstdlib>
+
+/*
+ * Errors (pushing to a full buffer, popping from an empty one, an index out of
+ * range in at(), ...) are reported with RING_BUFFER_THROW(exception).
+ *
+ * With exceptions enabled, the exception is thrown. When compiled with
+ * -fno-exceptions, or with RING_BUFFER_NO_EXCEPTIONS defined, the exception
+ * object is passed to RING_BUFFER_ERROR_HANDLER(exception) instead, which by
+ * default prints what() and aborts. It may be defined before including any RB
+ * header to report errors another way, but it must not return.
+ *
+ * Defining RING_BUFFER_UNCHECKED removes the empty check from pop(), which
+ * is then undefined on an empty buffer, like top() already is.
+ */
+
+#if !defined(RING_BUFFER_NO_EXCEPTIONS) \
+    && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS) && !defined(_CPPUNWIND)
+  #define RING_BUFFER_NO_EXCEPTIONS
+#endif
+
+#ifdef RING_BUFFER_NO_EXCEPTIONS
+  #ifndef RING_BUFFER_ERROR_HANDLER
+    #define RING_BUFFER_ERROR_HANDLER(exception) RB::detail::abortWith((exception).what())
+  #endif
+  #define RING_BUFFER_THROW(exception) RING_BUFFER_ERROR_HANDLER(exception)
+  #define RING_BUFFER_TRY if(true)
+  #define RING_BUFFER_CATCH_ALL else
+  #define RING_BUFFER_RETHROW
+#else
+  #define RING_BUFFER_THROW(exception) throw exception
+  #define RING_BUFFER_TRY try
+  #define RING_BUFFER_CATCH_ALL catch(...)
+  #define RING_BUFFER_RETHROW throw
+#endif
+
+namespace RB
+{
+namespace detail
+{
+
+[[noreturn]] inline void abortWith(const char* message)
+{
+    std::fprintf(stderr, "RB error: %s\n", message);
+    std::abort();
+}
+
+} // namespace detail
+} // namespace RB
+
+#endif
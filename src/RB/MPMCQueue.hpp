@@ -0,0 +1,103 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#ifndef RING_BUFFER_DEFAULT_CAPACITY
+  #define RING_BUFFER_DEFAULT_CAPACITY 32
+#endif
+
+#ifndef RING_BUFFER_CACHE_LINE_SIZE
+  #define RING_BUFFER_CACHE_LINE_SIZE 64
+#endif
+
+#include <cstdlib>
+#include <cstddef>
+
+#include <memory>
+#include <atomic>
+#include <type_traits>
+
+namespace RB
+{
+
+/*!
+ * A bounded lock-free queue that may be shared between any number of producer
+ * and consumer threads.
+ *
+ * Every slot carries a sequence number that says whether it is ready to be
+ * written or read for a given position, so producers only contend with each
+ * other on the write position and consumers only on the read position
+ * (Dmitry Vyukov's bounded MPMC queue). Slots and both positions are padded to
+ * separate cache lines.
+ *
+ * Like RingBuffer, the queue holds exactly "capacity" elements, and a capacity
+ * of 0 is valid (every try_push fails).
+ *
+ * A position is claimed before its slot is written or read, and other threads
+ * wait for that slot until it is published, so nothing may throw in between:
+ * T must be nothrow move constructible and nothrow move assignable. Elements
+ * whose construction from the try_emplace arguments may throw (a copy in
+ * try_push(const T&) for example) are built before a position is claimed,
+ * then moved into the slot, so an exception leaves the queue unchanged.
+ */
+template <typename T>
+class MPMCQueue
+{
+    static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+        "MPMCQueue requires a nothrow move constructible and move assignable T");
+
+public:
+    typedef T value_type;
+
+    MPMCQueue(std::size_t capacity = RING_BUFFER_DEFAULT_CAPACITY);
+    ~MPMCQueue();
+
+    // no copy or move, other threads may be using the queue
+    MPMCQueue(const MPMCQueue<T>& other) = delete;
+    MPMCQueue<T>& operator=(const MPMCQueue<T>& other) = delete;
+
+    bool try_push(const T& reference);
+    bool try_push(T&& r_value);
+    template <typename... Args>
+    bool try_emplace(Args&&... args);
+
+    bool try_pop(T& out);
+
+    /*!
+     * Only a snapshot when other threads are pushing or popping.
+     */
+    bool empty() const;
+    std::size_t getCapacity() const;
+    /*!
+     * Only a snapshot when other threads are pushing or popping.
+     */
+    std::size_t getSize() const;
+
+private:
+    struct alignas(RING_BUFFER_CACHE_LINE_SIZE) Slot
+    {
+        std::atomic<std::size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    const std::size_t bufferSize;
+    std::unique_ptr<unsigned char[]> memory;
+    Slot* slots;
+
+    alignas(RING_BUFFER_CACHE_LINE_SIZE) std::atomic<std::size_t> w;
+    alignas(RING_BUFFER_CACHE_LINE_SIZE) std::atomic<std::size_t> r;
+
+    static T* slotValue(Slot& slot);
+
+    // constructs in the claimed slot when that cannot throw, otherwise first
+    template <typename... Args>
+    bool tryEmplace(std::true_type, Args&&... args);
+    template <typename... Args>
+    bool tryEmplace(std::false_type, Args&&... args);
+
+};
+
+} // namespace RB
+
+#include "MPMCQueue.inl"
+
+#endif
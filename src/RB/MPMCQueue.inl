@@ -0,0 +1,192 @@
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+template <typename T>
+RB::MPMCQueue<T>::MPMCQueue(std::size_t capacity) :
+bufferSize(capacity),
+memory(),
+slots(nullptr),
+w(0),
+r(0)
+{
+    if(capacity != 0)
+    {
+        // new[] does not have to honor the alignment of Slot before C++17
+        std::size_t space = capacity * sizeof(Slot) + alignof(Slot) - 1;
+        memory = std::make_unique<unsigned char[]>(space);
+        void* aligned = memory.get();
+        std::align(alignof(Slot), capacity * sizeof(Slot), aligned, space);
+        slots = static_cast<Slot*>(aligned);
+
+        for(std::size_t i = 0; i < capacity; ++i)
+        {
+            new (&slots[i]) Slot;
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+RB::MPMCQueue<T>::~MPMCQueue()
+{
+    if(slots)
+    {
+        // no other thread may be using the queue at this point
+        for(std::size_t pos = r.load(std::memory_order_relaxed),
+                end = w.load(std::memory_order_relaxed);
+            pos != end;
+            ++pos)
+        {
+            slotValue(slots[pos % bufferSize])->~T();
+        }
+        for(std::size_t i = 0; i < bufferSize; ++i)
+        {
+            slots[i].~Slot();
+        }
+    }
+}
+
+template <typename T>
+bool RB::MPMCQueue<T>::try_push(const T& reference)
+{
+    return try_emplace(reference);
+}
+
+template <typename T>
+bool RB::MPMCQueue<T>::try_push(T&& r_value)
+{
+    return try_emplace(std::forward<T>(r_value));
+}
+
+template <typename T>
+template <typename... Args>
+bool RB::MPMCQueue<T>::try_emplace(Args&&... args)
+{
+    return tryEmplace(
+        std::integral_constant<bool, std::is_nothrow_constructible<T, Args&&...>::value>(),
+        std::forward<Args>(args)...);
+}
+
+template <typename T>
+template <typename... Args>
+bool RB::MPMCQueue<T>::tryEmplace(std::false_type, Args&&... args)
+{
+    // may throw before any position is claimed, moving it in cannot
+    return tryEmplace(std::true_type(), T(std::forward<Args>(args)...));
+}
+
+template <typename T>
+template <typename... Args>
+bool RB::MPMCQueue<T>::tryEmplace(std::true_type, Args&&... args)
+{
+    if(bufferSize == 0)
+    {
+        return false;
+    }
+
+    Slot* slot;
+    std::size_t pos = w.load(std::memory_order_relaxed);
+    while(true)
+    {
+        slot = &slots[pos % bufferSize];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = (std::intptr_t)sequence - (std::intptr_t)pos;
+        if(diff == 0)
+        {
+            // slot is free for this position, try to claim it
+            if(w.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if(diff < 0)
+        {
+            // slot still holds the value from one lap ago, queue is full
+            return false;
+        }
+        else
+        {
+            // another producer claimed this position
+            pos = w.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (&slot->storage) T(std::forward<Args>(args)...);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool RB::MPMCQueue<T>::try_pop(T& out)
+{
+    if(bufferSize == 0)
+    {
+        return false;
+    }
+
+    Slot* slot;
+    std::size_t pos = r.load(std::memory_order_relaxed);
+    while(true)
+    {
+        slot = &slots[pos % bufferSize];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = (std::intptr_t)sequence - (std::intptr_t)(pos + 1);
+        if(diff == 0)
+        {
+            // slot was published for this position, try to claim it
+            if(r.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if(diff < 0)
+        {
+            // slot has not been written yet, queue is empty
+            return false;
+        }
+        else
+        {
+            // another consumer claimed this position
+            pos = r.load(std::memory_order_relaxed);
+        }
+    }
+
+    T* value = slotValue(*slot);
+    out = std::move(*value);
+    value->~T();
+    slot->sequence.store(pos + bufferSize, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool RB::MPMCQueue<T>::empty() const
+{
+    return getSize() == 0;
+}
+
+template <typename T>
+std::size_t RB::MPMCQueue<T>::getCapacity() const
+{
+    return bufferSize;
+}
+
+template <typename T>
+std::size_t RB::MPMCQueue<T>::getSize() const
+{
+    const std::size_t currentR = r.load(std::memory_order_acquire);
+    const std::size_t currentW = w.load(std::memory_order_acquire);
+    // the positions are read separately, so clamp what a race can produce
+    if(currentW <= currentR)
+    {
+        return 0;
+    }
+    return currentW - currentR < bufferSize ? currentW - currentR : bufferSize;
+}
+
+template <typename T>
+T* RB::MPMCQueue<T>::slotValue(Slot& slot)
+{
+    return reinterpret_cast<T*>(&slot.storage);
+}
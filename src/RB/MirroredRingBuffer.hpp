@@ -0,0 +1,125 @@
+#ifndef MIRRORED_RING_BUFFER_HPP
+#define MIRRORED_RING_BUFFER_HPP
+
+#ifdef __linux__
+
+#ifndef RING_BUFFER_DEFAULT_CAPACITY
+  #define RING_BUFFER_DEFAULT_CAPACITY 32
+#endif
+
+#include <cstdlib>
+#include <cstddef>
+
+#include <type_traits>
+
+namespace RB
+{
+
+/*!
+ * A RingBuffer whose storage is mapped into memory twice, back to back, so
+ * that any run of up to getCapacity() elements starting at any index is
+ * contiguous in memory, even across the wrap point (Linux only).
+ *
+ * The capacity is rounded up so the storage is a whole number of pages, and
+ * T must be trivially copyable since every element is reachable through two
+ * addresses.
+ */
+template <typename T>
+class MirroredRingBuffer
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+        "MirroredRingBuffer requires a trivially copyable T");
+
+public:
+    typedef T value_type;
+
+    /*!
+     * Throws std::system_error if the memory could not be mapped.
+     */
+    MirroredRingBuffer(std::size_t capacity = RING_BUFFER_DEFAULT_CAPACITY);
+    ~MirroredRingBuffer();
+
+    // no copy
+    MirroredRingBuffer(const MirroredRingBuffer<T>& other) = delete;
+    MirroredRingBuffer<T>& operator=(const MirroredRingBuffer<T>& other) = delete;
+
+    // move, the moved from MirroredRingBuffer is left with a capacity of 0
+    MirroredRingBuffer(MirroredRingBuffer<T>&& other) noexcept;
+    MirroredRingBuffer<T>& operator=(MirroredRingBuffer<T>&& other) noexcept;
+
+    /*!
+     * Returns true if the oldest element was overwritten to make room, which
+     * can only happen when the overwrite policy is set.
+     */
+    bool push(const T& reference);
+    void pop();
+    T& top();
+
+    /*!
+     * Unchecked, index must be less than getCapacity(). Use at() for a bounds
+     * checked access.
+     */
+    T& operator [](std::size_t index);
+    const T& operator [](std::size_t index) const;
+
+    T& at(std::size_t index);
+    const T& at(std::size_t index) const;
+
+    /*!
+     * Returns a pointer to the element at index, followed in memory by the
+     * rest of the elements in order (and then the unused slots), so up to
+     * getCapacity() elements may be accessed from it. index must be less than
+     * getCapacity().
+     */
+    T* data(std::size_t index = 0);
+    const T* data(std::size_t index = 0) const;
+
+    /*!
+     * Returns a pointer to the unused slots after the last element, which
+     * are contiguous for getCapacity() - getSize() elements. Call commit(n)
+     * after writing to push n of them.
+     */
+    T* writeData();
+
+    /*!
+     * Pushes n elements written through writeData(). Throws
+     * std::out_of_range if there are fewer than n unused slots.
+     */
+    void commit(std::size_t n);
+
+    /*!
+     * Pops the first n elements. Throws std::out_of_range if there are fewer
+     * than n elements.
+     */
+    void discard(std::size_t n);
+
+    bool empty() const;
+    std::size_t getCapacity() const;
+    std::size_t getSize() const;
+
+    /*!
+     * Same as RingBuffer::setOverwritePolicy, if set to true pushing to a full
+     * MirroredRingBuffer overwrites the oldest element instead of throwing.
+     */
+    bool setOverwritePolicy(bool overwriteOldest);
+    bool getOverwritePolicy() const;
+
+private:
+    T* buffer;
+    std::size_t bufferSize;
+    std::size_t r;
+    std::size_t size;
+    bool overwritePolicy_overwriteOldest;
+
+    std::size_t wrapIndex(std::size_t index) const;
+    void unmap();
+
+};
+
+} // namespace RB
+
+#include "MirroredRingBuffer.inl"
+
+#endif // __linux__
+
+#endif
@@ -0,0 +1,269 @@
+
+#include <stdexcept>
+#include <system_error>
+#include <new>
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Error.hpp"
+
+template <typename T>
+RB::MirroredRingBuffer<T>::MirroredRingBuffer(std::size_t capacity) :
+buffer(nullptr),
+bufferSize(0),
+r(0),
+size(0),
+overwritePolicy_overwriteOldest(false)
+{
+    // whole pages that also hold a whole number of elements
+    const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+    std::size_t bytes = (capacity == 0 ? 1 : capacity) * sizeof(T);
+    bytes = (bytes + pageSize - 1) / pageSize * pageSize;
+    while(bytes % sizeof(T) != 0)
+    {
+        bytes += pageSize;
+    }
+
+    const int fd = memfd_create("RB::MirroredRingBuffer", MFD_CLOEXEC);
+    if(fd == -1)
+    {
+        RING_BUFFER_THROW(std::system_error(errno, std::generic_category(), "memfd_create"));
+    }
+    if(ftruncate(fd, bytes) == -1)
+    {
+        const int error = errno;
+        close(fd);
+        RING_BUFFER_THROW(std::system_error(error, std::generic_category(), "ftruncate"));
+    }
+
+    // reserve twice the size, then map the same pages into both halves
+    void* reserved = mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(reserved == MAP_FAILED)
+    {
+        const int error = errno;
+        close(fd);
+        RING_BUFFER_THROW(std::system_error(error, std::generic_category(), "mmap"));
+    }
+
+    char* base = static_cast<char*>(reserved);
+    if(mmap(base, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+        || mmap(base + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        const int error = errno;
+        munmap(reserved, 2 * bytes);
+        close(fd);
+        RING_BUFFER_THROW(std::system_error(error, std::generic_category(), "mmap"));
+    }
+
+    // the mappings keep the memory alive
+    close(fd);
+
+    buffer = reinterpret_cast<T*>(base);
+    bufferSize = bytes / sizeof(T);
+}
+
+template <typename T>
+RB::MirroredRingBuffer<T>::~MirroredRingBuffer()
+{
+    unmap();
+}
+
+template <typename T>
+RB::MirroredRingBuffer<T>::MirroredRingBuffer(RB::MirroredRingBuffer<T>&& other) noexcept :
+buffer(other.buffer),
+bufferSize(other.bufferSize),
+r(other.r),
+size(other.size),
+overwritePolicy_overwriteOldest(other.overwritePolicy_overwriteOldest)
+{
+    other.buffer = nullptr;
+    other.bufferSize = 0;
+    other.r = 0;
+    other.size = 0;
+}
+
+template <typename T>
+RB::MirroredRingBuffer<T>& RB::MirroredRingBuffer<T>::operator =(RB::MirroredRingBuffer<T>&& other) noexcept
+{
+    if(this != &other)
+    {
+        unmap();
+
+        buffer = other.buffer;
+        bufferSize = other.bufferSize;
+        r = other.r;
+        size = other.size;
+        overwritePolicy_overwriteOldest = other.overwritePolicy_overwriteOldest;
+
+        other.buffer = nullptr;
+        other.bufferSize = 0;
+        other.r = 0;
+        other.size = 0;
+    }
+    return *this;
+}
+
+template <typename T>
+bool RB::MirroredRingBuffer<T>::push(const T& reference)
+{
+    if(size == bufferSize)
+    {
+        if(!overwritePolicy_overwriteOldest || bufferSize == 0)
+        {
+            RING_BUFFER_THROW(std::out_of_range("MirroredRingBuffer max capacity reached, cannot push!"));
+        }
+        // the oldest element is in the slot being written
+        buffer[r] = reference;
+        r = wrapIndex(r + 1);
+        return true;
+    }
+
+    new (buffer + wrapIndex(r + size)) T(reference);
+    ++size;
+    return false;
+}
+
+template <typename T>
+void RB::MirroredRingBuffer<T>::pop()
+{
+#ifndef RING_BUFFER_UNCHECKED
+    if(size == 0)
+    {
+        RING_BUFFER_THROW(std::out_of_range("MirroredRingBuffer is empty, cannot pop!"));
+    }
+#endif
+
+    r = wrapIndex(r + 1);
+    --size;
+}
+
+template <typename T>
+T& RB::MirroredRingBuffer<T>::top()
+{
+    return buffer[r];
+}
+
+template <typename T>
+T& RB::MirroredRingBuffer<T>::operator [](std::size_t index)
+{
+    // no wrap needed, the second mapping continues where the first ends
+    return buffer[r + index];
+}
+
+template <typename T>
+const T& RB::MirroredRingBuffer<T>::operator [](std::size_t index) const
+{
+    return buffer[r + index];
+}
+
+template <typename T>
+T& RB::MirroredRingBuffer<T>::at(std::size_t index)
+{
+    if(index >= size)
+    {
+        RING_BUFFER_THROW(std::out_of_range("ERROR: Index is too large!"));
+    }
+
+    return buffer[r + index];
+}
+
+template <typename T>
+const T& RB::MirroredRingBuffer<T>::at(std::size_t index) const
+{
+    if(index >= size)
+    {
+        RING_BUFFER_THROW(std::out_of_range("ERROR: Index is too large!"));
+    }
+
+    return buffer[r + index];
+}
+
+template <typename T>
+T* RB::MirroredRingBuffer<T>::data(std::size_t index)
+{
+    return buffer + wrapIndex(r + index);
+}
+
+template <typename T>
+const T* RB::MirroredRingBuffer<T>::data(std::size_t index) const
+{
+    return buffer + wrapIndex(r + index);
+}
+
+template <typename T>
+T* RB::MirroredRingBuffer<T>::writeData()
+{
+    return buffer + wrapIndex(r + size);
+}
+
+template <typename T>
+void RB::MirroredRingBuffer<T>::commit(std::size_t n)
+{
+    if(n > bufferSize - size)
+    {
+        RING_BUFFER_THROW(std::out_of_range("MirroredRingBuffer does not have enough space, cannot commit!"));
+    }
+
+    size += n;
+}
+
+template <typename T>
+void RB::MirroredRingBuffer<T>::discard(std::size_t n)
+{
+    if(n > size)
+    {
+        RING_BUFFER_THROW(std::out_of_range("MirroredRingBuffer has too few elements, cannot pop!"));
+    }
+
+    r = wrapIndex(r + n);
+    size -= n;
+}
+
+template <typename T>
+bool RB::MirroredRingBuffer<T>::empty() const
+{
+    return size == 0;
+}
+
+template <typename T>
+std::size_t RB::MirroredRingBuffer<T>::getCapacity() const
+{
+    return bufferSize;
+}
+
+template <typename T>
+std::size_t RB::MirroredRingBuffer<T>::getSize() const
+{
+    return size;
+}
+
+template <typename T>
+bool RB::MirroredRingBuffer<T>::setOverwritePolicy(bool overwriteOldest) {
+    bool prev = overwritePolicy_overwriteOldest;
+    overwritePolicy_overwriteOldest = overwriteOldest;
+    return prev;
+}
+
+template <typename T>
+bool RB::MirroredRingBuffer<T>::getOverwritePolicy() const {
+    return overwritePolicy_overwriteOldest;
+}
+
+template <typename T>
+std::size_t RB::MirroredRingBuffer<T>::wrapIndex(std::size_t index) const
+{
+    // callers pass less than 2 * bufferSize, so one subtraction is enough
+    return index >= bufferSize ? index - bufferSize : index;
+}
+
+template <typename T>
+void RB::MirroredRingBuffer<T>::unmap()
+{
+    if(buffer)
+    {
+        munmap(buffer, 2 * bufferSize * sizeof(T));
+        buffer = nullptr;
+    }
+}
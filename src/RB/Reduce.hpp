@@ -0,0 +1,114 @@
+#ifndef RING_BUFFER_REDUCE_HPP
+#define RING_BUFFER_REDUCE_HPP
+
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+
+#include "RingBuffer.hpp"
+
+namespace RB
+{
+
+/*
+ * Reductions over every element of a RingBuffer<float> or
+ * RingBuffer<std::int32_t>, running vector kernels over the (at most two)
+ * contiguous runs from readSpans() instead of stepping an Iterator, whose
+ * index wrapping keeps the compiler from vectorizing the loop.
+ *
+ * The kernels are written once with the GCC/Clang vector extensions and
+ * compiled for each SimdLevel. The level is picked at run time from what the
+ * CPU supports (see getSimdLevel), other compilers always use plain loops.
+ *
+ * Vector kernels add floats in a different order than a plain loop, so float
+ * results may differ from std::accumulate in the last bits (usually they are
+ * closer to the exact sum). Integer results are exact: sums and dot products
+ * of std::int32_t are accumulated in std::int64_t.
+ */
+
+/*!
+ * Scalar: plain loops.
+ * Vector128: 128 bit vectors, SSE4.1 on x86, the baseline vector unit (NEON
+ * on AArch64 for example) elsewhere.
+ * Vector256: 256 bit vectors, AVX2 on x86.
+ */
+enum class SimdLevel
+{
+    Scalar,
+    Vector128,
+    Vector256
+};
+
+/*!
+ * The widest level this CPU supports, detected once.
+ */
+SimdLevel detectSimdLevel();
+
+/*!
+ * The level the reductions use, detectSimdLevel() unless set otherwise.
+ */
+SimdLevel getSimdLevel();
+
+/*!
+ * Makes the reductions use level, or the widest supported level below it,
+ * for every thread (to compare levels, or to avoid the clock drop wide
+ * vectors cause on some CPUs). Returns the previous level.
+ */
+SimdLevel setSimdLevel(SimdLevel level);
+
+/*!
+ * The accumulator types of the reductions of T: sum_type for sum and dot,
+ * real_type for variance.
+ */
+template <typename T>
+struct ReduceTraits;
+
+template <>
+struct ReduceTraits<float>
+{
+    typedef float sum_type;
+    typedef float real_type;
+};
+
+template <>
+struct ReduceTraits<std::int32_t>
+{
+    typedef std::int64_t sum_type;
+    typedef double real_type;
+};
+
+/*!
+ * The sum of the elements, 0 when empty.
+ */
+template <typename T, typename Allocator>
+typename ReduceTraits<T>::sum_type sum(const RingBuffer<T, Allocator>& ringBuffer);
+
+/*!
+ * The smallest (largest) element. Throws std::out_of_range if the RingBuffer
+ * is empty. Which element is returned when floats contain NaN is unspecified.
+ */
+template <typename T, typename Allocator>
+T minimum(const RingBuffer<T, Allocator>& ringBuffer);
+template <typename T, typename Allocator>
+T maximum(const RingBuffer<T, Allocator>& ringBuffer);
+
+/*!
+ * The sum of a[i] * b[i]. The two RingBuffers may wrap at different
+ * indices. Throws std::out_of_range if their sizes differ.
+ */
+template <typename T, typename AllocatorA, typename AllocatorB>
+typename ReduceTraits<T>::sum_type dot(const RingBuffer<T, AllocatorA>& a, const RingBuffer<T, AllocatorB>& b);
+
+/*!
+ * The population variance (the mean squared distance to the mean), computed
+ * in two passes so it stays accurate when the mean is large. NaN when
+ * empty.
+ */
+template <typename T, typename Allocator>
+typename ReduceTraits<T>::real_type variance(const RingBuffer<T, Allocator>& ringBuffer);
+
+} // namespace RB
+
+#include "Reduce.inl"
+
+#endif
@@ -0,0 +1,612 @@
+
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#include "Error.hpp"
+
+#ifdef __GNUC__
+  #define RING_BUFFER_VECTOR_KERNELS
+  #define RING_BUFFER_ALWAYS_INLINE __attribute__((always_inline))
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #include <immintrin.h>
+  #define RING_BUFFER_X86_KERNELS
+  #define RING_BUFFER_TARGET_VECTOR128 __attribute__((target("sse4.1")))
+  #define RING_BUFFER_TARGET_VECTOR256 __attribute__((target("avx2")))
+#else
+  #define RING_BUFFER_TARGET_VECTOR128
+  #define RING_BUFFER_TARGET_VECTOR256
+#endif
+
+namespace RB
+{
+namespace detail
+{
+
+/*!
+ * Plain loops, for the Scalar level and the tails of the vector kernels.
+ * T is the element type, A the accumulator type.
+ */
+template <typename T, typename A>
+struct ScalarKernels
+{
+    static A sum(const T* data, std::size_t n)
+    {
+        A result = A();
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            result += data[i];
+        }
+        return result;
+    }
+
+    static T minimum(const T* data, std::size_t n, T result)
+    {
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            result = std::min(result, data[i]);
+        }
+        return result;
+    }
+
+    static T maximum(const T* data, std::size_t n, T result)
+    {
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            result = std::max(result, data[i]);
+        }
+        return result;
+    }
+
+    static A dot(const T* a, const T* b, std::size_t n)
+    {
+        A result = A();
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            result += static_cast<A>(a[i]) * static_cast<A>(b[i]);
+        }
+        return result;
+    }
+
+    static A squaredDeviation(const T* data, std::size_t n, A mean)
+    {
+        A result = A();
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            const A deviation = static_cast<A>(data[i]) - mean;
+            result += deviation * deviation;
+        }
+        return result;
+    }
+};
+
+#ifdef RING_BUFFER_VECTOR_KERNELS
+
+/*!
+ * The same kernels on vectors of Bytes bytes. They are always inlined into
+ * the per level functions below, so they are compiled for that level's
+ * instruction set. Several accumulators are used in turn, so consecutive
+ * additions do not wait on each other.
+ */
+template <typename T, typename A, std::size_t Bytes>
+struct VectorKernels
+{
+    // minimum and maximum compare whole vectors of T, the other kernels
+    // load as many T as there are A in a vector, so accumulators that are
+    // wider than T (std::int64_t for std::int32_t) still fill one register
+    static const std::size_t lanes = Bytes / (sizeof(A) > sizeof(T) ? sizeof(A) : sizeof(T));
+    static const std::size_t unroll = 4;
+    static const std::size_t block = unroll * lanes;
+    static const std::size_t compareLanes = Bytes / sizeof(T);
+    static const std::size_t compareBlock = unroll * compareLanes;
+
+    typedef T Vector __attribute__((vector_size(lanes * sizeof(T))));
+    typedef A AccumulatorVector __attribute__((vector_size(lanes * sizeof(A))));
+    typedef T CompareVector __attribute__((vector_size(Bytes)));
+
+    RING_BUFFER_ALWAYS_INLINE static A sum(const T* data, std::size_t n)
+    {
+        AccumulatorVector accumulators[unroll] = {};
+        std::size_t i = 0;
+        for(; i + block <= n; i += block)
+        {
+            for(std::size_t u = 0; u < unroll; ++u)
+            {
+                Vector x;
+                std::memcpy(&x, data + i + u * lanes, sizeof(x));
+                accumulators[u] += __builtin_convertvector(x, AccumulatorVector);
+            }
+        }
+        for(; i + lanes <= n; i += lanes)
+        {
+            Vector x;
+            std::memcpy(&x, data + i, sizeof(x));
+            accumulators[0] += __builtin_convertvector(x, AccumulatorVector);
+        }
+        return horizontalSum(accumulators) + ScalarKernels<T, A>::sum(data + i, n - i);
+    }
+
+    RING_BUFFER_ALWAYS_INLINE static T minimum(const T* data, std::size_t n, T result)
+    {
+        if(n < compareBlock)
+        {
+            return ScalarKernels<T, A>::minimum(data, n, result);
+        }
+
+        CompareVector accumulators[unroll];
+        std::memcpy(accumulators, data, sizeof(accumulators));
+        std::size_t i = compareBlock;
+        for(; i + compareBlock <= n; i += compareBlock)
+        {
+            for(std::size_t u = 0; u < unroll; ++u)
+            {
+                CompareVector x;
+                std::memcpy(&x, data + i + u * compareLanes, sizeof(x));
+                accumulators[u] = x < accumulators[u] ? x : accumulators[u];
+            }
+        }
+        for(std::size_t u = 0; u < unroll; ++u)
+        {
+            for(std::size_t lane = 0; lane < compareLanes; ++lane)
+            {
+                result = std::min(result, static_cast<T>(accumulators[u][lane]));
+            }
+        }
+        return ScalarKernels<T, A>::minimum(data + i, n - i, result);
+    }
+
+    RING_BUFFER_ALWAYS_INLINE static T maximum(const T* data, std::size_t n, T result)
+    {
+        if(n < compareBlock)
+        {
+            return ScalarKernels<T, A>::maximum(data, n, result);
+        }
+
+        CompareVector accumulators[unroll];
+        std::memcpy(accumulators, data, sizeof(accumulators));
+        std::size_t i = compareBlock;
+        for(; i + compareBlock <= n; i += compareBlock)
+        {
+            for(std::size_t u = 0; u < unroll; ++u)
+            {
+                CompareVector x;
+                std::memcpy(&x, data + i + u * compareLanes, sizeof(x));
+                accumulators[u] = x > accumulators[u] ? x : accumulators[u];
+            }
+        }
+        for(std::size_t u = 0; u < unroll; ++u)
+        {
+            for(std::size_t lane = 0; lane < compareLanes; ++lane)
+            {
+                result = std::max(result, static_cast<T>(accumulators[u][lane]));
+            }
+        }
+        return ScalarKernels<T, A>::maximum(data + i, n - i, result);
+    }
+
+    RING_BUFFER_ALWAYS_INLINE static A dot(const T* a, const T* b, std::size_t n)
+    {
+        AccumulatorVector accumulators[unroll] = {};
+        std::size_t i = 0;
+        for(; i + block <= n; i += block)
+        {
+            for(std::size_t u = 0; u < unroll; ++u)
+            {
+                Vector x;
+                Vector y;
+                std::memcpy(&x, a + i + u * lanes, sizeof(x));
+                std::memcpy(&y, b + i + u * lanes, sizeof(y));
+                accumulators[u] += __builtin_convertvector(x, AccumulatorVector)
+                    * __builtin_convertvector(y, AccumulatorVector);
+            }
+        }
+        return horizontalSum(accumulators) + ScalarKernels<T, A>::dot(a + i, b + i, n - i);
+    }
+
+    RING_BUFFER_ALWAYS_INLINE static A squaredDeviation(const T* data, std::size_t n, A mean)
+    {
+        AccumulatorVector means;
+        for(std::size_t lane = 0; lane < lanes; ++lane)
+        {
+            means[lane] = mean;
+        }
+
+        AccumulatorVector accumulators[unroll] = {};
+        std::size_t i = 0;
+        for(; i + block <= n; i += block)
+        {
+            for(std::size_t u = 0; u < unroll; ++u)
+            {
+                Vector x;
+                std::memcpy(&x, data + i + u * lanes, sizeof(x));
+                const AccumulatorVector deviation = __builtin_convertvector(x, AccumulatorVector) - means;
+                accumulators[u] += deviation * deviation;
+            }
+        }
+        return horizontalSum(accumulators) + ScalarKernels<T, A>::squaredDeviation(data + i, n - i, mean);
+    }
+
+    RING_BUFFER_ALWAYS_INLINE static A horizontalSum(const AccumulatorVector (&accumulators)[unroll])
+    {
+        const AccumulatorVector total = (accumulators[0] + accumulators[1]) + (accumulators[2] + accumulators[3]);
+        A result = A();
+        for(std::size_t lane = 0; lane < lanes; ++lane)
+        {
+            result += total[lane];
+        }
+        return result;
+    }
+};
+
+// one function per level and kernel, each compiled for its instruction set
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR128 A sumVector128(const T* data, std::size_t n)
+{
+    return VectorKernels<T, A, 16>::sum(data, n);
+}
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR256 A sumVector256(const T* data, std::size_t n)
+{
+    return VectorKernels<T, A, 32>::sum(data, n);
+}
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR128 T minimumVector128(const T* data, std::size_t n, T result)
+{
+    return VectorKernels<T, A, 16>::minimum(data, n, result);
+}
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR256 T minimumVector256(const T* data, std::size_t n, T result)
+{
+    return VectorKernels<T, A, 32>::minimum(data, n, result);
+}
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR128 T maximumVector128(const T* data, std::size_t n, T result)
+{
+    return VectorKernels<T, A, 16>::maximum(data, n, result);
+}
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR256 T maximumVector256(const T* data, std::size_t n, T result)
+{
+    return VectorKernels<T, A, 32>::maximum(data, n, result);
+}
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR128 A dotVector128(const T* a, const T* b, std::size_t n)
+{
+    return VectorKernels<T, A, 16>::dot(a, b, n);
+}
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR256 A dotVector256(const T* a, const T* b, std::size_t n)
+{
+    return VectorKernels<T, A, 32>::dot(a, b, n);
+}
+
+#ifdef RING_BUFFER_X86_KERNELS
+
+/*
+ * GCC does not see that std::int32_t products widened to std::int64_t are
+ * what pmuldq computes (it multiplies the low, sign extended halves of 64 bit
+ * lanes) and emulates a full 64 bit multiply instead, so the std::int32_t
+ * dot products are written with intrinsics: the even lanes are multiplied in
+ * place, the odd ones after shifting them down.
+ */
+
+template <>
+RING_BUFFER_TARGET_VECTOR128 inline std::int64_t dotVector128<std::int32_t, std::int64_t>(
+    const std::int32_t* a, const std::int32_t* b, std::size_t n)
+{
+    __m128i accumulators[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+    {
+        for(std::size_t u = 0; u < 2; ++u)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 4 * u));
+            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 4 * u));
+            const __m128i even = _mm_mul_epi32(x, y);
+            const __m128i odd = _mm_mul_epi32(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32));
+            accumulators[u] = _mm_add_epi64(accumulators[u], _mm_add_epi64(even, odd));
+        }
+    }
+
+    std::int64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(accumulators[0], accumulators[1]));
+    return lanes[0] + lanes[1] + ScalarKernels<std::int32_t, std::int64_t>::dot(a + i, b + i, n - i);
+}
+
+template <>
+RING_BUFFER_TARGET_VECTOR256 inline std::int64_t dotVector256<std::int32_t, std::int64_t>(
+    const std::int32_t* a, const std::int32_t* b, std::size_t n)
+{
+    __m256i accumulators[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+    std::size_t i = 0;
+    for(; i + 16 <= n; i += 16)
+    {
+        for(std::size_t u = 0; u < 2; ++u)
+        {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 8 * u));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 8 * u));
+            const __m256i even = _mm256_mul_epi32(x, y);
+            const __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+            accumulators[u] = _mm256_add_epi64(accumulators[u], _mm256_add_epi64(even, odd));
+        }
+    }
+
+    std::int64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(accumulators[0], accumulators[1]));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3]
+        + ScalarKernels<std::int32_t, std::int64_t>::dot(a + i, b + i, n - i);
+}
+
+#endif // RING_BUFFER_X86_KERNELS
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR128 A squaredDeviationVector128(const T* data, std::size_t n, A mean)
+{
+    return VectorKernels<T, A, 16>::squaredDeviation(data, n, mean);
+}
+
+template <typename T, typename A>
+RING_BUFFER_TARGET_VECTOR256 A squaredDeviationVector256(const T* data, std::size_t n, A mean)
+{
+    return VectorKernels<T, A, 32>::squaredDeviation(data, n, mean);
+}
+
+#ifdef RING_BUFFER_X86_KERNELS
+
+/*
+ * SSE4.1 converts only two std::int32_t to double per instruction (cvtdq2pd),
+ * one per element like the scalar loop, so the vector loop is no faster and
+ * std::int32_t variance stays scalar at this level.
+ */
+
+template <>
+inline double squaredDeviationVector128<std::int32_t, double>(const std::int32_t* data, std::size_t n, double mean)
+{
+    return ScalarKernels<std::int32_t, double>::squaredDeviation(data, n, mean);
+}
+
+#endif // RING_BUFFER_X86_KERNELS
+
+#endif // RING_BUFFER_VECTOR_KERNELS
+
+inline std::atomic<int>& simdLevel()
+{
+    static std::atomic<int> level(static_cast<int>(RB::detectSimdLevel()));
+    return level;
+}
+
+// dispatch one contiguous run to the kernel of the current level
+
+template <typename T, typename A>
+A sumRun(const T* data, std::size_t n)
+{
+    switch(RB::getSimdLevel())
+    {
+#ifdef RING_BUFFER_VECTOR_KERNELS
+    case SimdLevel::Vector256:
+        return sumVector256<T, A>(data, n);
+    case SimdLevel::Vector128:
+        return sumVector128<T, A>(data, n);
+#endif
+    default:
+        return ScalarKernels<T, A>::sum(data, n);
+    }
+}
+
+template <typename T, typename A>
+T minimumRun(const T* data, std::size_t n, T result)
+{
+    switch(RB::getSimdLevel())
+    {
+#ifdef RING_BUFFER_VECTOR_KERNELS
+    case SimdLevel::Vector256:
+        return minimumVector256<T, A>(data, n, result);
+    case SimdLevel::Vector128:
+        return minimumVector128<T, A>(data, n, result);
+#endif
+    default:
+        return ScalarKernels<T, A>::minimum(data, n, result);
+    }
+}
+
+template <typename T, typename A>
+T maximumRun(const T* data, std::size_t n, T result)
+{
+    switch(RB::getSimdLevel())
+    {
+#ifdef RING_BUFFER_VECTOR_KERNELS
+    case SimdLevel::Vector256:
+        return maximumVector256<T, A>(data, n, result);
+    case SimdLevel::Vector128:
+        return maximumVector128<T, A>(data, n, result);
+#endif
+    default:
+        return ScalarKernels<T, A>::maximum(data, n, result);
+    }
+}
+
+template <typename T, typename A>
+A dotRun(const T* a, const T* b, std::size_t n)
+{
+    switch(RB::getSimdLevel())
+    {
+#ifdef RING_BUFFER_VECTOR_KERNELS
+    case SimdLevel::Vector256:
+        return dotVector256<T, A>(a, b, n);
+    case SimdLevel::Vector128:
+        return dotVector128<T, A>(a, b, n);
+#endif
+    default:
+        return ScalarKernels<T, A>::dot(a, b, n);
+    }
+}
+
+template <typename T, typename A>
+A squaredDeviationRun(const T* data, std::size_t n, A mean)
+{
+    switch(RB::getSimdLevel())
+    {
+#ifdef RING_BUFFER_VECTOR_KERNELS
+    case SimdLevel::Vector256:
+        return squaredDeviationVector256<T, A>(data, n, mean);
+    case SimdLevel::Vector128:
+        return squaredDeviationVector128<T, A>(data, n, mean);
+#endif
+    default:
+        return ScalarKernels<T, A>::squaredDeviation(data, n, mean);
+    }
+}
+
+} // namespace detail
+} // namespace RB
+
+inline RB::SimdLevel RB::detectSimdLevel()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    // also checks that the OS saves the AVX registers
+    static const SimdLevel level = __builtin_cpu_supports("avx2") ? SimdLevel::Vector256
+        : __builtin_cpu_supports("sse4.1") ? SimdLevel::Vector128
+        : SimdLevel::Scalar;
+    return level;
+#elif defined(RING_BUFFER_VECTOR_KERNELS)
+    return SimdLevel::Vector128;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+inline RB::SimdLevel RB::getSimdLevel()
+{
+    return static_cast<SimdLevel>(detail::simdLevel().load(std::memory_order_relaxed));
+}
+
+inline RB::SimdLevel RB::setSimdLevel(RB::SimdLevel level)
+{
+    const int supported = std::min(static_cast<int>(level), static_cast<int>(detectSimdLevel()));
+    return static_cast<SimdLevel>(detail::simdLevel().exchange(supported, std::memory_order_relaxed));
+}
+
+template <typename T, typename Allocator>
+typename RB::ReduceTraits<T>::sum_type RB::sum(const RB::RingBuffer<T, Allocator>& ringBuffer)
+{
+    typedef typename ReduceTraits<T>::sum_type A;
+    A result = A();
+    for(const auto& span : ringBuffer.readSpans())
+    {
+        result += detail::sumRun<T, A>(span.data, span.size);
+    }
+    return result;
+}
+
+template <typename T, typename Allocator>
+T RB::minimum(const RB::RingBuffer<T, Allocator>& ringBuffer)
+{
+    if(ringBuffer.empty())
+    {
+        RING_BUFFER_THROW(std::out_of_range("RingBuffer is empty, no minimum!"));
+    }
+
+    typedef typename ReduceTraits<T>::sum_type A;
+    const auto spans = ringBuffer.readSpans();
+    T result = spans[0].data[0];
+    for(const auto& span : spans)
+    {
+        result = detail::minimumRun<T, A>(span.data, span.size, result);
+    }
+    return result;
+}
+
+template <typename T, typename Allocator>
+T RB::maximum(const RB::RingBuffer<T, Allocator>& ringBuffer)
+{
+    if(ringBuffer.empty())
+    {
+        RING_BUFFER_THROW(std::out_of_range("RingBuffer is empty, no maximum!"));
+    }
+
+    typedef typename ReduceTraits<T>::sum_type A;
+    const auto spans = ringBuffer.readSpans();
+    T result = spans[0].data[0];
+    for(const auto& span : spans)
+    {
+        result = detail::maximumRun<T, A>(span.data, span.size, result);
+    }
+    return result;
+}
+
+template <typename T, typename AllocatorA, typename AllocatorB>
+typename RB::ReduceTraits<T>::sum_type RB::dot(const RB::RingBuffer<T, AllocatorA>& a, const RB::RingBuffer<T, AllocatorB>& b)
+{
+    if(a.getSize() != b.getSize())
+    {
+        RING_BUFFER_THROW(std::out_of_range("RingBuffers have different sizes, no dot product!"));
+    }
+
+    // walk both pairs of runs at once, every step is contiguous in both
+    typedef typename ReduceTraits<T>::sum_type A;
+    const auto spansA = a.readSpans();
+    const auto spansB = b.readSpans();
+    A result = A();
+    std::size_t spanA = 0;
+    std::size_t spanB = 0;
+    std::size_t offsetA = 0;
+    std::size_t offsetB = 0;
+    while(spanA < 2 && spanB < 2)
+    {
+        const std::size_t n = std::min(spansA[spanA].size - offsetA, spansB[spanB].size - offsetB);
+        if(n != 0)
+        {
+            result += detail::dotRun<T, A>(spansA[spanA].data + offsetA, spansB[spanB].data + offsetB, n);
+        }
+        offsetA += n;
+        offsetB += n;
+        if(offsetA == spansA[spanA].size)
+        {
+            ++spanA;
+            offsetA = 0;
+        }
+        if(offsetB == spansB[spanB].size)
+        {
+            ++spanB;
+            offsetB = 0;
+        }
+    }
+    return result;
+}
+
+template <typename T, typename Allocator>
+typename RB::ReduceTraits<T>::real_type RB::variance(const RB::RingBuffer<T, Allocator>& ringBuffer)
+{
+    typedef typename ReduceTraits<T>::real_type R;
+    const std::size_t n = ringBuffer.getSize();
+    if(n == 0)
+    {
+        return std::numeric_limits<R>::quiet_NaN();
+    }
+
+    const R mean = static_cast<R>(sum(ringBuffer)) / n;
+    R result = R();
+    for(const auto& span : ringBuffer.readSpans())
+    {
+        result += detail::squaredDeviationRun<T, R>(span.data, span.size, mean);
+    }
+    return result / n;
+}
+
+#undef RING_BUFFER_VECTOR_KERNELS
+#undef RING_BUFFER_X86_KERNELS
+#undef RING_BUFFER_ALWAYS_INLINE
+#undef RING_BUFFER_TARGET_VECTOR128
+#undef RING_BUFFER_TARGET_VECTOR256
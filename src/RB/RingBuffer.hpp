@@ -8,33 +8,202 @@
 #include <cstddef>
 
 #include <memory>
-#include <bitset>
+#include <array>
+#include <iterator>
 #include <type_traits>
 
 namespace RB
 {
 
-template <typename T>
+/*!
+ * Allocator is used for the buffer and to construct and destroy elements. Its
+ * pointer type must be a plain T*. Copy, move and swap follow the allocator's
+ * propagate_on_container_* traits like the standard containers do.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
 class RingBuffer
 {
 public:
     typedef T value_type;
+    typedef Allocator allocator_type;
 
-    RingBuffer(std::size_t capacity = RING_BUFFER_DEFAULT_CAPACITY);
+    /*!
+     * Only allocates memory for "capacity" elements, elements are constructed
+     * when pushed and destroyed when popped, so T does not need to be default
+     * constructible.
+     */
+    RingBuffer(
+        std::size_t capacity = RING_BUFFER_DEFAULT_CAPACITY,
+        const Allocator& allocator = Allocator());
+    ~RingBuffer();
 
     // copy
-    RingBuffer(const RingBuffer<T>& other);
-    RingBuffer<T>& operator=(const RingBuffer<T>& other);
+    RingBuffer(const RingBuffer<T, Allocator>& other);
+    RingBuffer<T, Allocator>& operator=(const RingBuffer<T, Allocator>& other);
+
+    // move, the moved from RingBuffer is left empty with a capacity of 0.
+    // Only pointers and indices change hands, so moves don't throw unless
+    // assignment has to move element by element between unequal allocators.
+    RingBuffer(RingBuffer<T, Allocator>&& other) noexcept;
+    RingBuffer<T, Allocator>& operator=(RingBuffer<T, Allocator>&& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+        || std::allocator_traits<Allocator>::is_always_equal::value);
+
+    void swap(RingBuffer<T, Allocator>& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_swap::value
+        || std::allocator_traits<Allocator>::is_always_equal::value);
+    Allocator get_allocator() const;
 
-    // move
-    RingBuffer(RingBuffer<T>&& other) = default;
-    RingBuffer<T>& operator=(RingBuffer<T>&& other) = default;
+    /*!
+     * Returns true if the oldest element was overwritten to make room, which
+     * can only happen when the overwrite policy is set.
+     */
+    bool push(const T& reference);
+    bool push(T&& r_value);
 
-    void push(const T& reference);
-    void push(T&& r_value);
+    /*!
+     * Constructs an element from args directly in its slot and returns a
+     * reference to it. Full buffers are handled as by push(), when the oldest
+     * element is overwritten, a T is built from args and move assigned to it.
+     */
+    template <typename... Args>
+    T& emplace(Args&&... args);
+
+    /*!
+     * Removes the oldest element. Throws std::out_of_range if empty.
+     *
+     * When the shrink policy is set, any pop (pop, try_pop, pop_back,
+     * pop_into, discard) may change the capacity, which reallocates: it can
+     * throw std::bad_alloc, and invalidates references and iterators from
+     * top(), operator[] and the rest.
+     */
     void pop();
     T& top();
 
+    /*!
+     * Same as push/emplace, but return false instead of throwing if the
+     * RingBuffer is full and may neither grow nor overwrite the oldest
+     * element. Returns true if the element was pushed.
+     */
+    bool try_push(const T& reference);
+    bool try_push(T&& r_value);
+    template <typename... Args>
+    bool try_emplace(Args&&... args);
+
+    /*!
+     * Moves the top element to out and pops it. Returns false, leaving out
+     * unchanged, if the RingBuffer is empty.
+     */
+    bool try_pop(T& out);
+
+    /*!
+     * Same as push/emplace, but adds the element before top(), so it is the
+     * next one popped. When the buffer is full and the overwrite policy is
+     * set, the newest element (the one back() returns) is overwritten.
+     */
+    bool push_front(const T& reference);
+    bool push_front(T&& r_value);
+    template <typename... Args>
+    T& emplace_front(Args&&... args);
+
+    /*!
+     * Removes the newest element. Throws std::out_of_range if empty.
+     */
+    void pop_back();
+
+    /*!
+     * Unchecked, the newest element. The RingBuffer must not be empty.
+     */
+    T& back();
+    const T& back() const;
+
+    /*!
+     * Pushes every element in [first, last) with one capacity check, copying
+     * into at most two contiguous runs of the buffer (with memcpy when T is
+     * trivially copyable and the range is a pointer range).
+     *
+     * For forward iterators, throws std::out_of_range without pushing
+     * anything if the range does not fit, unless the overwrite policy is set.
+     * Then the oldest elements are dropped to make room (including leading
+     * elements of the range when it is longer than the capacity), and the
+     * number dropped is returned. If a copy then throws, the dropped elements
+     * stay dropped, and the elements copied so far stay pushed. Single-pass
+     * input iterators can't be measured up front, so they are pushed one
+     * element at a time, as by push(), and may be partially pushed before the
+     * exception.
+     *
+     * Like memcpy, the trivially copyable fast path does not call the
+     * Allocator's construct.
+     */
+    template <typename InputIt,
+        typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    std::size_t push(InputIt first, InputIt last);
+
+    /*!
+     * Moves the first n elements to "out" and pops them, in at most two
+     * contiguous runs (with memcpy when T is trivially copyable and "out" is a
+     * T*). Returns "out" advanced past the last element written.
+     *
+     * Throws std::out_of_range without popping anything if there are fewer
+     * than n elements. May reallocate under the shrink policy, as pop() does.
+     */
+    template <typename OutputIt>
+    OutputIt pop_into(OutputIt out, std::size_t n);
+
+    /*!
+     * Pops the first n elements. Throws std::out_of_range without popping
+     * anything if there are fewer than n elements. May reallocate under the
+     * shrink policy, as pop() does.
+     */
+    void discard(std::size_t n);
+
+    struct Span
+    {
+        T* data;
+        std::size_t size;
+    };
+
+    struct ConstSpan
+    {
+        const T* data;
+        std::size_t size;
+    };
+
+    /*!
+     * Returns the elements as at most two contiguous runs, in order. Unused
+     * runs have a size of 0. After reading (or moving from) elements through
+     * these, call discard(n) to pop them.
+     */
+    std::array<Span, 2> readSpans();
+    std::array<ConstSpan, 2> readSpans() const;
+
+    /*!
+     * Returns the unused slots after the last element as at most two
+     * contiguous runs, in order. These slots hold no objects, so for
+     * non-trivial T they must be filled with placement new. Call commit(n)
+     * afterwards to push the first n of them.
+     */
+    std::array<Span, 2> writeSpans();
+
+    /*!
+     * Same as writeSpans(), but the runs hold exactly n slots. If there are
+     * fewer than n unused slots, the capacity grows when the growth policy is
+     * set, otherwise std::out_of_range is thrown. Construct the elements in
+     * place (for example deserialize into them), then call commit(n).
+     */
+    std::array<Span, 2> claim(std::size_t n);
+
+    /*!
+     * Pushes the first n slots returned by writeSpans() or claim(), which
+     * must have been constructed. Throws std::out_of_range if there are fewer
+     * than n unused slots.
+     */
+    void commit(std::size_t n);
+
+    /*!
+     * Unchecked, index must be less than getCapacity(). Use at() for a bounds
+     * checked access.
+     */
     T& operator [](std::size_t index);
     const T& operator [](std::size_t index) const;
 
@@ -45,14 +214,30 @@ public:
     std::size_t getCapacity() const;
     std::size_t getSize() const;
 
+    /*!
+     * Moves the elements to new storage of newCapacity, truncating according
+     * to the resize policy. Elements are moved if their move constructor is
+     * noexcept and copied otherwise, so if a copy throws the RingBuffer is
+     * left unchanged.
+     */
     void changeCapacity(std::size_t newCapacity);
     void reserve(std::size_t newCapacity);
 
+    /*!
+     * Truncates according to the resize policy, or appends copies of toCopy.
+     * Throws std::out_of_range if newSize is greater than the capacity.
+     * Truncating is O(1) when T is trivially destructible.
+     */
     void changeSize(std::size_t newSize);
     void changeSize(std::size_t newSize, const T& toCopy);
     void resize(std::size_t newSize);
     void resize(std::size_t newSize, const T& toCopy);
 
+    /*!
+     * Destroys all elements, the capacity is unchanged.
+     */
+    void clear();
+
     /*!
      * If set to true, resizing the RingBuffer to a size smaller than the
      * current size will preserve the front end of the buffer and truncate the
@@ -67,17 +252,126 @@ public:
     bool setResizePolicy(bool preserveFront);
     bool getResizePolicy() const;
 
+    /*!
+     * If set to true, pushing to a full RingBuffer overwrites the oldest
+     * element (the one top() returns) instead of throwing std::out_of_range,
+     * so the RingBuffer keeps the last "capacity" elements pushed.
+     *
+     * A RingBuffer with a capacity of 0 always throws on push.
+     *
+     * By default, pushing to a full RingBuffer throws (as if this function was
+     * called with "false").
+     */
+    bool setOverwritePolicy(bool overwriteOldest);
+    bool getOverwritePolicy() const;
+
+    /*!
+     * If growthFactor is greater than 1, pushing to a full RingBuffer changes
+     * the capacity to capacity * growthFactor (rounded up, and at least enough
+     * for the pushed elements) instead of throwing, so push is amortized O(1).
+     * This takes precedence over the overwrite policy. A range pushed with
+     * push(first, last) must not refer to this RingBuffer's elements.
+     *
+     * Returns the previous growth factor. By default, the growth factor is 0
+     * and the capacity never grows.
+     */
+    double setGrowthPolicy(double growthFactor = 2.0);
+    double getGrowthPolicy() const;
+
+    /*!
+     * If shrinkThreshold is greater than 0 and the growth policy is set,
+     * popping (see pop()) until the size is less than
+     * capacity * shrinkThreshold changes the capacity to size * growth
+     * factor, at least 1, to give memory back after a burst. Keep
+     * shrinkThreshold below 1 / growth factor, e.g. 0.25 for a factor of 2,
+     * so the RingBuffer does not shrink and grow back repeatedly.
+     *
+     * Without growth the capacity never shrinks, since a fixed capacity
+     * RingBuffer could not grow back to it.
+     *
+     * Returns the previous threshold. By default, the threshold is 0 and the
+     * capacity never shrinks.
+     */
+    double setShrinkPolicy(double shrinkThreshold);
+    double getShrinkPolicy() const;
+
 private:
     std::size_t r;
     std::size_t w;
     std::size_t bufferSize;
     bool isEmpty;
     bool resizePolicy_preserveFront;
-    std::unique_ptr<T[]> buffer;
-
-    void checkPush() const;
+    bool overwritePolicy_overwriteOldest;
+    double growthPolicy_factor;
+    double shrinkPolicy_threshold;
+    typedef std::allocator_traits<Allocator> AllocatorTraits;
+    static_assert(std::is_same<typename AllocatorTraits::pointer, T*>::value,
+        "RingBuffer requires an Allocator whose pointer type is T*");
+
+    // only the slots from r up to w hold constructed elements
+    T* buffer;
+    Allocator allocator;
+
+    bool checkPush() const;
     void checkPop() const;
-    void copyRingBuffer(const RingBuffer<T>& other);
+    // returns true if the oldest element was overwritten
+    template <typename... Args>
+    bool emplaceAtW(Args&&... args);
+    template <typename... Args>
+    bool emplaceBeforeR(Args&&... args);
+    template <typename U,
+        typename = std::enable_if_t<std::is_same<std::decay_t<U>, T>::value>>
+    void assignSlot(T& slot, U&& value);
+    template <typename... Args>
+    void assignSlot(T& slot, Args&&... args);
+    bool isFull() const;
+    bool mustGrow() const;
+    bool canPush() const;
+    // the grown capacity, at least minimum
+    std::size_t grownCapacity(std::size_t minimum) const;
+    void shrinkIfSparse();
+    template <typename Pointer>
+    using CanMemcpy = std::integral_constant<bool,
+        std::is_trivially_copyable<T>::value
+        && std::is_pointer<Pointer>::value
+        && std::is_same<std::remove_cv_t<std::remove_pointer_t<Pointer>>, T>::value>;
+
+    template <typename InputIt>
+    std::size_t pushRange(InputIt first, InputIt last, std::input_iterator_tag);
+    template <typename ForwardIt>
+    std::size_t pushRange(ForwardIt first, ForwardIt last, std::forward_iterator_tag);
+    // n must not reach past the end of the buffer from w or r
+    template <typename ForwardIt>
+    ForwardIt constructAtW(ForwardIt first, std::size_t n, std::true_type);
+    template <typename ForwardIt>
+    ForwardIt constructAtW(ForwardIt first, std::size_t n, std::false_type);
+    void fillAtW(const T& value, std::size_t n, std::true_type);
+    void fillAtW(const T& value, std::size_t n, std::false_type);
+    template <typename OutputIt>
+    OutputIt moveFromR(OutputIt out, std::size_t n, std::true_type);
+    template <typename OutputIt>
+    OutputIt moveFromR(OutputIt out, std::size_t n, std::false_type);
+
+    // wrap around without the integer division of "% bufferSize"
+    std::size_t nextIndex(std::size_t index) const;
+    std::size_t prevIndex(std::size_t index) const;
+    std::size_t wrapIndex(std::size_t index) const;
+    void copyRingBuffer(const RingBuffer<T, Allocator>& other);
+    // destroys n elements from storage index first, a no-op when trivial
+    void destroyElements(std::size_t first, std::size_t n, std::true_type);
+    void destroyElements(std::size_t first, std::size_t n, std::false_type);
+    // constructs n elements starting at logical index first into newBuffer
+    void relocateTo(T* newBuffer, std::size_t first, std::size_t n, std::true_type);
+    void relocateTo(T* newBuffer, std::size_t first, std::size_t n, std::false_type);
+    T* allocate(std::size_t capacity);
+    void deallocate(T* buffer, std::size_t capacity);
+    // only replace the allocator when the matching propagate trait is true
+    void copyAllocator(const Allocator& other, std::true_type);
+    void copyAllocator(const Allocator& other, std::false_type);
+    void moveAllocator(Allocator& other, std::true_type);
+    void moveAllocator(Allocator& other, std::false_type);
+    void swapAllocator(Allocator& other, std::true_type);
+    void swapAllocator(Allocator& other, std::false_type);
 
 public:
     template <bool IsConst>
@@ -90,60 +384,45 @@ public:
         typedef std::conditional_t<IsConst, const T*, T*> pointer;
         typedef std::random_access_iterator_tag iterator_category;
 
-        typedef RingBuffer<T> parent_type;
+        typedef std::conditional_t<IsConst,
+            const RingBuffer<T, Allocator>,
+            RingBuffer<T, Allocator>> parent_type;
 
         Iterator();
-        Iterator(
-            const std::size_t& r,
-            const std::size_t& w,
-            const std::size_t& bufferSize,
-            const std::size_t& index,
-            bool isEmpty,
-            bool isEnd,
-            pointer buffer
-        );
-
-        // copy
-        Iterator(const Iterator& other) = default;
-        Iterator& operator =(const Iterator& other) = default;
-
-        // move
-        Iterator(Iterator&& other) = default;
-        Iterator& operator =(Iterator&& other) = default;
-
-        reference operator *();
-        Iterator& operator ++();
+        Iterator(parent_type* parent, std::size_t position);
 
-        bool operator ==(const Iterator& other) const;
+        reference operator *() const;
+        pointer operator ->() const;
+        reference operator [](const difference_type& n) const;
 
-        bool operator !=(const Iterator& other) const;
-        pointer operator ->();
+        Iterator& operator ++();
         Iterator operator ++(int);
-
         Iterator& operator --();
         Iterator operator --(int);
 
         Iterator& operator +=(const difference_type& n);
-        Iterator operator +(const difference_type& n);
+        Iterator operator +(const difference_type& n) const;
         Iterator& operator -=(const difference_type& n);
-        Iterator operator -(const difference_type& n);
-        difference_type operator -(const Iterator& other);
-        reference operator [](const difference_type& n);
+        Iterator operator -(const difference_type& n) const;
+        difference_type operator -(const Iterator& other) const;
+
+        friend Iterator operator +(const difference_type& n, const Iterator& iter)
+        {
+            return iter + n;
+        }
+
+        bool operator ==(const Iterator& other) const;
+        bool operator !=(const Iterator& other) const;
         bool operator <(const Iterator& other) const;
         bool operator >(const Iterator& other) const;
         bool operator >=(const Iterator& other) const;
         bool operator <=(const Iterator& other) const;
 
     private:
-        std::size_t r;
-        std::size_t w;
-        std::size_t bufferSize;
-        std::size_t index;
-        // 0 - isEmpty
-        // 1 - initialized
-        // 2 - past the end reached
-        std::bitset<3> flags;
-        pointer buffer;
+        // two words and trivially copyable, so it stays in registers
+        parent_type* parent;
+        // logical position, 0 is the top and getSize() is the end
+        std::size_t position;
 
     };
 
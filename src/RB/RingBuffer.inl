@@ -1,132 +1,512 @@
 #include <stdexcept>
 #include <limits>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
 
-template <typename T>
-RB::RingBuffer<T>::RingBuffer(std::size_t capacity) :
+#include "Error.hpp"
+
+template <typename T, typename Allocator>
+RB::RingBuffer<T, Allocator>::RingBuffer(std::size_t capacity, const Allocator& allocator) :
 r(0),
 w(0),
 isEmpty(true),
-resizePolicy_preserveFront(true)
+resizePolicy_preserveFront(true),
+overwritePolicy_overwriteOldest(false),
+growthPolicy_factor(0),
+shrinkPolicy_threshold(0),
+buffer(nullptr),
+allocator(allocator)
 {
     if(capacity != 0)
     {
-        buffer = std::make_unique<T[]>(capacity);
+        buffer = allocate(capacity);
     }
     bufferSize = capacity;
 }
 
-template <typename T>
-RB::RingBuffer<T>::RingBuffer(const RB::RingBuffer<T>& other) :
+template <typename T, typename Allocator>
+RB::RingBuffer<T, Allocator>::~RingBuffer()
+{
+    clear();
+    deallocate(buffer, bufferSize);
+}
+
+template <typename T, typename Allocator>
+RB::RingBuffer<T, Allocator>::RingBuffer(const RB::RingBuffer<T, Allocator>& other) :
 r(0),
-w(0)
+w(0),
+bufferSize(0),
+isEmpty(true),
+buffer(nullptr),
+allocator(AllocatorTraits::select_on_container_copy_construction(other.allocator))
 {
     copyRingBuffer(other);
 }
 
-template <typename T>
-RB::RingBuffer<T>& RB::RingBuffer<T>::operator =(const RB::RingBuffer<T>& other)
+template <typename T, typename Allocator>
+RB::RingBuffer<T, Allocator>& RB::RingBuffer<T, Allocator>::operator =(const RB::RingBuffer<T, Allocator>& other)
 {
-    copyRingBuffer(other);
+    if(this != &other)
+    {
+        if(AllocatorTraits::propagate_on_container_copy_assignment::value
+            && allocator != other.allocator)
+        {
+            // memory from the old allocator must go back to it
+            clear();
+            deallocate(buffer, bufferSize);
+            buffer = nullptr;
+            bufferSize = 0;
+        }
+        copyAllocator(other.allocator,
+            typename AllocatorTraits::propagate_on_container_copy_assignment());
+        copyRingBuffer(other);
+    }
     return *this;
 }
 
-template <typename T>
-void RB::RingBuffer<T>::push(const T& reference)
+template <typename T, typename Allocator>
+RB::RingBuffer<T, Allocator>::RingBuffer(RB::RingBuffer<T, Allocator>&& other) noexcept :
+r(other.r),
+w(other.w),
+bufferSize(other.bufferSize),
+isEmpty(other.isEmpty),
+resizePolicy_preserveFront(other.resizePolicy_preserveFront),
+overwritePolicy_overwriteOldest(other.overwritePolicy_overwriteOldest),
+growthPolicy_factor(other.growthPolicy_factor),
+shrinkPolicy_threshold(other.shrinkPolicy_threshold),
+buffer(other.buffer),
+allocator(std::move(other.allocator))
 {
-#ifndef NDEBUG
-//    std::clog << "RingBuffer<T>::push(const T&) called" << std::endl;
-#endif
-    checkPush();
+    other.r = 0;
+    other.w = 0;
+    other.bufferSize = 0;
+    other.isEmpty = true;
+    other.buffer = nullptr;
+}
 
-    T value = reference;
+template <typename T, typename Allocator>
+RB::RingBuffer<T, Allocator>& RB::RingBuffer<T, Allocator>::operator =(RB::RingBuffer<T, Allocator>&& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+    || std::allocator_traits<Allocator>::is_always_equal::value)
+{
+    if(this != &other)
+    {
+        if(!AllocatorTraits::propagate_on_container_move_assignment::value
+            && allocator != other.allocator)
+        {
+            // other's memory can't be freed by this allocator, move by element
+            clear();
+            if(bufferSize != other.bufferSize)
+            {
+                deallocate(buffer, bufferSize);
+                buffer = nullptr;
+                bufferSize = 0;
+                if(other.bufferSize != 0)
+                {
+                    buffer = allocate(other.bufferSize);
+                    bufferSize = other.bufferSize;
+                }
+            }
+            while(!other.empty())
+            {
+                push(std::move(other.top()));
+                other.pop();
+            }
+            resizePolicy_preserveFront = other.resizePolicy_preserveFront;
+            overwritePolicy_overwriteOldest = other.overwritePolicy_overwriteOldest;
+            growthPolicy_factor = other.growthPolicy_factor;
+            shrinkPolicy_threshold = other.shrinkPolicy_threshold;
+            return *this;
+        }
 
-    buffer[w] = std::move(value);
-    w = (w + 1) % bufferSize;
+        clear();
+        deallocate(buffer, bufferSize);
+        moveAllocator(other.allocator,
+            typename AllocatorTraits::propagate_on_container_move_assignment());
+
+        r = other.r;
+        w = other.w;
+        bufferSize = other.bufferSize;
+        isEmpty = other.isEmpty;
+        resizePolicy_preserveFront = other.resizePolicy_preserveFront;
+        overwritePolicy_overwriteOldest = other.overwritePolicy_overwriteOldest;
+        growthPolicy_factor = other.growthPolicy_factor;
+        shrinkPolicy_threshold = other.shrinkPolicy_threshold;
+        buffer = other.buffer;
+
+        other.r = 0;
+        other.w = 0;
+        other.bufferSize = 0;
+        other.isEmpty = true;
+        other.buffer = nullptr;
+    }
+    return *this;
+}
 
-    isEmpty = false;
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::swap(RB::RingBuffer<T, Allocator>& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_swap::value
+    || std::allocator_traits<Allocator>::is_always_equal::value)
+{
+    using std::swap;
+    swap(r, other.r);
+    swap(w, other.w);
+    swap(bufferSize, other.bufferSize);
+    swap(isEmpty, other.isEmpty);
+    swap(resizePolicy_preserveFront, other.resizePolicy_preserveFront);
+    swap(overwritePolicy_overwriteOldest, other.overwritePolicy_overwriteOldest);
+    swap(growthPolicy_factor, other.growthPolicy_factor);
+    swap(shrinkPolicy_threshold, other.shrinkPolicy_threshold);
+    swap(buffer, other.buffer);
+    swapAllocator(other.allocator,
+        typename AllocatorTraits::propagate_on_container_swap());
 }
 
-template <typename T>
-void RB::RingBuffer<T>::push(T&& r_value)
+template <typename T, typename Allocator>
+Allocator RB::RingBuffer<T, Allocator>::get_allocator() const
+{
+    return allocator;
+}
+
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::push(const T& reference)
+{
+#ifndef NDEBUG
+//    std::clog << "RingBuffer<T>::push(const T&) called" << std::endl;
+#endif
+    return emplaceAtW(reference);
+}
+
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::push(T&& r_value)
 {
 #ifndef NDEBUG
 //    std::clog << "RingBuffer<T>::push(T&&) called" << std::endl;
 #endif
-    checkPush();
+    return emplaceAtW(std::move(r_value));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+T& RB::RingBuffer<T, Allocator>::emplace(Args&&... args)
+{
+    emplaceAtW(std::forward<Args>(args)...);
+    return buffer[prevIndex(w)];
+}
 
-    buffer[w] = std::forward<T>(r_value);
-    w = (w + 1) % bufferSize;
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::try_push(const T& reference)
+{
+    return try_emplace(reference);
+}
 
-    isEmpty = false;
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::try_push(T&& r_value)
+{
+    return try_emplace(std::move(r_value));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+bool RB::RingBuffer<T, Allocator>::try_emplace(Args&&... args)
+{
+    if(!canPush())
+    {
+        return false;
+    }
+    emplaceAtW(std::forward<Args>(args)...);
+    return true;
+}
+
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::try_pop(T& out)
+{
+    if(isEmpty)
+    {
+        return false;
+    }
+    out = std::move(buffer[r]);
+    pop();
+    return true;
+}
+
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::push_front(const T& reference)
+{
+    return emplaceBeforeR(reference);
+}
+
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::push_front(T&& r_value)
+{
+    return emplaceBeforeR(std::move(r_value));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+T& RB::RingBuffer<T, Allocator>::emplace_front(Args&&... args)
+{
+    emplaceBeforeR(std::forward<Args>(args)...);
+    return buffer[r];
 }
 
-template <typename T>
-void RB::RingBuffer<T>::pop()
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::pop()
 {
     checkPop();
 
-    r = (r + 1) % bufferSize;
+    AllocatorTraits::destroy(allocator, buffer + r);
+    r = nextIndex(r);
+
+    if(r == w)
+    {
+        isEmpty = true;
+    }
+    if(shrinkPolicy_threshold > 0)
+    {
+        shrinkIfSparse();
+    }
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt, typename>
+std::size_t RB::RingBuffer<T, Allocator>::push(InputIt first, InputIt last)
+{
+    return pushRange(first, last,
+        typename std::iterator_traits<InputIt>::iterator_category());
+}
+
+template <typename T, typename Allocator>
+template <typename OutputIt>
+OutputIt RB::RingBuffer<T, Allocator>::pop_into(OutputIt out, std::size_t n)
+{
+    if(n > getSize())
+    {
+        RING_BUFFER_THROW(std::out_of_range("RingBuffer has too few elements, cannot pop!"));
+    }
+    else if(n == 0)
+    {
+        return out;
+    }
+
+    const std::size_t firstCount = std::min(n, bufferSize - r);
+    out = moveFromR(out, firstCount, CanMemcpy<OutputIt>());
+    if(firstCount != n)
+    {
+        // r has wrapped to the start of the buffer (see pushRange)
+        r = 0;
+        out = moveFromR(out, n - firstCount, CanMemcpy<OutputIt>());
+    }
+
+    if(r == w)
+    {
+        isEmpty = true;
+    }
+    if(shrinkPolicy_threshold > 0)
+    {
+        shrinkIfSparse();
+    }
+    return out;
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::discard(std::size_t n)
+{
+    if(n > getSize())
+    {
+        RING_BUFFER_THROW(std::out_of_range("RingBuffer has too few elements, cannot pop!"));
+    }
+    else if(n == 0)
+    {
+        return;
+    }
+
+    destroyElements(r, n, std::is_trivially_destructible<T>());
+    r = wrapIndex(r + n);
 
     if(r == w)
     {
         isEmpty = true;
     }
+    if(shrinkPolicy_threshold > 0)
+    {
+        shrinkIfSparse();
+    }
+}
+
+template <typename T, typename Allocator>
+std::array<typename RB::RingBuffer<T, Allocator>::Span, 2> RB::RingBuffer<T, Allocator>::readSpans()
+{
+    if(isEmpty)
+    {
+        return {{{buffer, 0}, {buffer, 0}}};
+    }
+    else if(r < w)
+    {
+        return {{{buffer + r, w - r}, {buffer, 0}}};
+    }
+    else
+    {
+        return {{{buffer + r, bufferSize - r}, {buffer, w}}};
+    }
+}
+
+template <typename T, typename Allocator>
+std::array<typename RB::RingBuffer<T, Allocator>::ConstSpan, 2> RB::RingBuffer<T, Allocator>::readSpans() const
+{
+    if(isEmpty)
+    {
+        return {{{buffer, 0}, {buffer, 0}}};
+    }
+    else if(r < w)
+    {
+        return {{{buffer + r, w - r}, {buffer, 0}}};
+    }
+    else
+    {
+        return {{{buffer + r, bufferSize - r}, {buffer, w}}};
+    }
+}
+
+template <typename T, typename Allocator>
+std::array<typename RB::RingBuffer<T, Allocator>::Span, 2> RB::RingBuffer<T, Allocator>::writeSpans()
+{
+    if(!isEmpty && r == w)
+    {
+        return {{{buffer, 0}, {buffer, 0}}};
+    }
+    else if(w < r)
+    {
+        return {{{buffer + w, r - w}, {buffer, 0}}};
+    }
+    else
+    {
+        return {{{buffer + w, bufferSize - w}, {buffer, r}}};
+    }
+}
+
+template <typename T, typename Allocator>
+std::array<typename RB::RingBuffer<T, Allocator>::Span, 2> RB::RingBuffer<T, Allocator>::claim(std::size_t n)
+{
+    const std::size_t size = getSize();
+    if(n > bufferSize - size)
+    {
+        if(growthPolicy_factor <= 1)
+        {
+            RING_BUFFER_THROW(std::out_of_range("RingBuffer does not have enough space, cannot claim!"));
+        }
+        changeCapacity(grownCapacity(size + n));
+    }
+
+    std::array<Span, 2> spans = writeSpans();
+    spans[0].size = std::min(spans[0].size, n);
+    spans[1].size = std::min(spans[1].size, n - spans[0].size);
+    return spans;
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::commit(std::size_t n)
+{
+    if(n > bufferSize - getSize())
+    {
+        RING_BUFFER_THROW(std::out_of_range("RingBuffer does not have enough space, cannot commit!"));
+    }
+    else if(n == 0)
+    {
+        return;
+    }
+
+    w = wrapIndex(w + n);
+    isEmpty = false;
 }
 
-template <typename T>
-T& RB::RingBuffer<T>::top()
+template <typename T, typename Allocator>
+T& RB::RingBuffer<T, Allocator>::top()
 {
     return buffer[r];
 }
 
-template <typename T>
-T& RB::RingBuffer<T>::operator [](std::size_t index)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::pop_back()
+{
+    checkPop();
+
+    w = prevIndex(w);
+    AllocatorTraits::destroy(allocator, buffer + w);
+
+    if(r == w)
+    {
+        isEmpty = true;
+    }
+    if(shrinkPolicy_threshold > 0)
+    {
+        shrinkIfSparse();
+    }
+}
+
+template <typename T, typename Allocator>
+T& RB::RingBuffer<T, Allocator>::back()
 {
-    return buffer[(index + r) % bufferSize];
+    return buffer[prevIndex(w)];
 }
 
-template <typename T>
-const T& RB::RingBuffer<T>::operator [](std::size_t index) const
+template <typename T, typename Allocator>
+const T& RB::RingBuffer<T, Allocator>::back() const
 {
-    return buffer[(index + r) % bufferSize];
+    return buffer[prevIndex(w)];
 }
 
-template <typename T>
-T& RB::RingBuffer<T>::at(std::size_t index)
+template <typename T, typename Allocator>
+T& RB::RingBuffer<T, Allocator>::operator [](std::size_t index)
+{
+    return buffer[wrapIndex(index + r)];
+}
+
+template <typename T, typename Allocator>
+const T& RB::RingBuffer<T, Allocator>::operator [](std::size_t index) const
+{
+    return buffer[wrapIndex(index + r)];
+}
+
+template <typename T, typename Allocator>
+T& RB::RingBuffer<T, Allocator>::at(std::size_t index)
 {
     if(index >= getSize())
     {
-        throw std::out_of_range("ERROR: Index is too large!");
+        RING_BUFFER_THROW(std::out_of_range("ERROR: Index is too large!"));
     }
 
     return (*this)[index];
 }
 
-template <typename T>
-const T& RB::RingBuffer<T>::at(std::size_t index) const
+template <typename T, typename Allocator>
+const T& RB::RingBuffer<T, Allocator>::at(std::size_t index) const
 {
     if(index >= getSize())
     {
-        throw std::out_of_range("ERROR: Index is too large!");
+        RING_BUFFER_THROW(std::out_of_range("ERROR: Index is too large!"));
     }
 
     return (*this)[index];
 }
 
-template <typename T>
-bool RB::RingBuffer<T>::empty() const
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::empty() const
 {
     return isEmpty;
 }
 
-template <typename T>
-std::size_t RB::RingBuffer<T>::getCapacity() const
+template <typename T, typename Allocator>
+std::size_t RB::RingBuffer<T, Allocator>::getCapacity() const
 {
     return bufferSize;
 }
 
-template <typename T>
-std::size_t RB::RingBuffer<T>::getSize() const
+template <typename T, typename Allocator>
+std::size_t RB::RingBuffer<T, Allocator>::getSize() const
 {
     if(isEmpty)
     {
@@ -138,493 +518,797 @@ std::size_t RB::RingBuffer<T>::getSize() const
     }
 }
 
-template <typename T>
-void RB::RingBuffer<T>::changeCapacity(std::size_t newCapacity)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::changeCapacity(std::size_t newCapacity)
 {
     const std::size_t size = getSize();
-    std::unique_ptr<T[]> newBuffer = std::make_unique<T[]>(newCapacity);
-    if(!isEmpty)
+    const std::size_t kept = size < newCapacity ? size : newCapacity;
+    const std::size_t first = resizePolicy_preserveFront ? 0 : size - kept;
+    T* newBuffer = newCapacity != 0 ? allocate(newCapacity) : nullptr;
+    RING_BUFFER_TRY
     {
-        if(newCapacity < size && !resizePolicy_preserveFront) {
-            std::size_t diff = size - newCapacity;
-            for(std::size_t i = 0; i < size && i < newCapacity; ++i) {
-                newBuffer[i] = buffer[(r + diff + i) % bufferSize];
-            }
-        } else {
-            for(std::size_t i = 0; i < size && i < newCapacity; ++i)
-            {
-                newBuffer[i] = buffer[(r + i) % bufferSize];
-            }
-        }
+        relocateTo(newBuffer, first, kept, CanMemcpy<T*>());
     }
-
-    r = 0;
-    if(size < newCapacity)
-    {
-        w = size;
-    }
-    else
+    RING_BUFFER_CATCH_ALL
     {
-        w = 0;
+        // the old buffer is still intact
+        deallocate(newBuffer, newCapacity);
+        RING_BUFFER_RETHROW;
     }
-    buffer = std::move(newBuffer);
+
+    // the kept elements were relocated, every old element is destroyed
+    clear();
+    deallocate(buffer, bufferSize);
+
+    r = 0;
+    w = kept < newCapacity ? kept : 0;
+    buffer = newBuffer;
     bufferSize = newCapacity;
-    if(newCapacity == 0)
-    {
-        isEmpty = true;
-    }
+    isEmpty = kept == 0;
 }
 
-template <typename T>
-void RB::RingBuffer<T>::reserve(std::size_t newCapacity)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::reserve(std::size_t newCapacity)
 {
     changeCapacity(newCapacity);
 }
 
-template <typename T>
-void RB::RingBuffer<T>::changeSize(std::size_t newSize)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::changeSize(std::size_t newSize)
 {
     changeSize(newSize, T());
 }
 
-template <typename T>
-void RB::RingBuffer<T>::changeSize(std::size_t newSize, const T& toCopy)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::changeSize(std::size_t newSize, const T& toCopy)
 {
     if(newSize > bufferSize)
     {
-        throw std::out_of_range("ERROR: newSize is greater than bufferSize!");
+        RING_BUFFER_THROW(std::out_of_range("ERROR: newSize is greater than bufferSize!"));
     }
 
-    std::size_t size = getSize();
-    if(newSize < size)
+    const std::size_t size = getSize();
+    if(newSize == 0)
     {
-        if(newSize == 0) {
-            r = 0;
-            w = 0;
-            isEmpty = true;
-        } else if(resizePolicy_preserveFront) {
-            for(unsigned int i = 0; i < size - newSize; ++i)
-            {
-                if(w == 0)
-                {
-                    w = bufferSize - 1;
-                }
-                else
-                {
-                    --w;
-                }
-                if(w == r)
-                {
-                    isEmpty = true;
-                }
-            }
-        } else {
-            for(unsigned int i = 0; i < size - newSize; ++i) {
-                if(r + 1 >= bufferSize) {
-                    r = 0;
-                } else {
-                    ++r;
-                }
-                if(r == w) {
-                    isEmpty = true;
-                }
-            }
+        clear();
+    }
+    else if(newSize < size)
+    {
+        const std::size_t truncated = size - newSize;
+        if(resizePolicy_preserveFront)
+        {
+            const std::size_t newW = wrapIndex(r + newSize);
+            destroyElements(newW, truncated, std::is_trivially_destructible<T>());
+            w = newW;
+        }
+        else
+        {
+            destroyElements(r, truncated, std::is_trivially_destructible<T>());
+            r = wrapIndex(r + truncated);
         }
     }
-    else
+    else if(newSize > size)
     {
-        for(unsigned int i = 0; i < newSize - size; ++i)
+        const std::size_t count = newSize - size;
+        const std::size_t firstCount = std::min(count, bufferSize - w);
+        fillAtW(toCopy, firstCount, CanMemcpy<T*>());
+        if(firstCount != count)
         {
-            isEmpty = false;
-            buffer[w++] = toCopy;
-            if(w == bufferSize)
-            {
-                w = 0;
-            }
+            w = 0;
+            fillAtW(toCopy, count - firstCount, CanMemcpy<T*>());
         }
     }
 }
 
-template <typename T>
-void RB::RingBuffer<T>::resize(std::size_t newSize)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::clear()
+{
+    destroyElements(r, getSize(), std::is_trivially_destructible<T>());
+    r = 0;
+    w = 0;
+    isEmpty = true;
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::resize(std::size_t newSize)
 {
     changeSize(newSize);
 }
 
-template <typename T>
-void RB::RingBuffer<T>::resize(std::size_t newSize, const T& toCopy)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::resize(std::size_t newSize, const T& toCopy)
 {
     changeSize(newSize, toCopy);
 }
 
-template <typename T>
-bool RB::RingBuffer<T>::setResizePolicy(bool preserveFront) {
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::setResizePolicy(bool preserveFront) {
     bool prev = resizePolicy_preserveFront;
     resizePolicy_preserveFront = preserveFront;
     return prev;
 }
 
-template <typename T>
-bool RB::RingBuffer<T>::getResizePolicy() const {
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::getResizePolicy() const {
     return resizePolicy_preserveFront;
 }
 
-template <typename T>
-void RB::RingBuffer<T>::checkPush() const
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::setOverwritePolicy(bool overwriteOldest) {
+    bool prev = overwritePolicy_overwriteOldest;
+    overwritePolicy_overwriteOldest = overwriteOldest;
+    return prev;
+}
+
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::getOverwritePolicy() const {
+    return overwritePolicy_overwriteOldest;
+}
+
+template <typename T, typename Allocator>
+double RB::RingBuffer<T, Allocator>::setGrowthPolicy(double growthFactor) {
+    double prev = growthPolicy_factor;
+    growthPolicy_factor = growthFactor;
+    return prev;
+}
+
+template <typename T, typename Allocator>
+double RB::RingBuffer<T, Allocator>::getGrowthPolicy() const {
+    return growthPolicy_factor;
+}
+
+template <typename T, typename Allocator>
+double RB::RingBuffer<T, Allocator>::setShrinkPolicy(double shrinkThreshold) {
+    double prev = shrinkPolicy_threshold;
+    shrinkPolicy_threshold = shrinkThreshold;
+    return prev;
+}
+
+template <typename T, typename Allocator>
+double RB::RingBuffer<T, Allocator>::getShrinkPolicy() const {
+    return shrinkPolicy_threshold;
+}
+
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::checkPush() const
 {
-    if(!isEmpty && r == w)
+    if(bufferSize == 0)
     {
-        throw std::out_of_range("RingBuffer max capacity reached, cannot push!");
+        RING_BUFFER_THROW(std::out_of_range("RingBuffer has no capacity, cannot push!"));
     }
+    else if(!isEmpty && r == w)
+    {
+        if(overwritePolicy_overwriteOldest)
+        {
+            return true;
+        }
+        RING_BUFFER_THROW(std::out_of_range("RingBuffer max capacity reached, cannot push!"));
+    }
+    return false;
 }
 
-template <typename T>
-void RB::RingBuffer<T>::checkPop() const
+template <typename T, typename Allocator>
+template <typename... Args>
+bool RB::RingBuffer<T, Allocator>::emplaceAtW(Args&&... args)
 {
-    if(isEmpty)
+    if(mustGrow())
     {
-        throw std::out_of_range("RingBuffer is empty, cannot pop!");
+        // the arguments may refer to elements about to be relocated
+        T value(std::forward<Args>(args)...);
+        changeCapacity(grownCapacity(bufferSize + 1));
+        return emplaceAtW(std::move(value));
     }
-}
+    const bool overwrite = checkPush();
 
-template <typename T>
-void RB::RingBuffer<T>::copyRingBuffer(const RB::RingBuffer<T>& other)
-{
-    r = 0;
-    w = 0;
-    isEmpty = true;
-    buffer = std::make_unique<T[]>(other.bufferSize);
-    bufferSize = other.bufferSize;
-    if(other.buffer && !other.isEmpty)
+    if(overwrite)
     {
-        isEmpty = false;
-        for(std::size_t i = other.r;
-            i != other.w;
-            i = (i + 1) % bufferSize)
-        {
-            buffer[w] = other.buffer[i];
-            w = w + 1; // shouldn't need to use modulo
-        }
+        // the slot still holds the oldest element, which the arguments may
+        // refer to, so it is assigned to instead of destroyed and rebuilt
+        assignSlot(buffer[w], std::forward<Args>(args)...);
+    }
+    else
+    {
+        AllocatorTraits::construct(allocator, buffer + w, std::forward<Args>(args)...);
+    }
+    w = nextIndex(w);
+    if(overwrite)
+    {
+        r = w;
     }
+
+    isEmpty = false;
+    return overwrite;
 }
 
-template <typename T>
-template <bool IsConst>
-RB::RingBuffer<T>::Iterator<IsConst>::Iterator() :
-r(0),
-w(0),
-bufferSize(0),
-index(0),
-flags(),
-buffer(nullptr)
+template <typename T, typename Allocator>
+template <typename... Args>
+bool RB::RingBuffer<T, Allocator>::emplaceBeforeR(Args&&... args)
 {
-    flags.set(0);
+    if(mustGrow())
+    {
+        T value(std::forward<Args>(args)...);
+        changeCapacity(grownCapacity(bufferSize + 1));
+        return emplaceBeforeR(std::move(value));
+    }
+    const bool overwrite = checkPush();
+
+    // when full, the slot before r is the one before w, the newest element
+    const std::size_t slot = prevIndex(r);
+    if(overwrite)
+    {
+        assignSlot(buffer[slot], std::forward<Args>(args)...);
+    }
+    else
+    {
+        AllocatorTraits::construct(allocator, buffer + slot, std::forward<Args>(args)...);
+    }
+    r = slot;
+    if(overwrite)
+    {
+        w = r;
+    }
+
+    isEmpty = false;
+    return overwrite;
 }
 
-template <typename T>
-template <bool IsConst>
-RB::RingBuffer<T>::Iterator<IsConst>::Iterator(
-    const std::size_t& r,
-    const std::size_t& w,
-    const std::size_t& bufferSize,
-    const std::size_t& index,
-    bool isEmpty,
-    bool isEnd,
-    pointer buffer
-) :
-r(r),
-w(w),
-bufferSize(bufferSize),
-index(index),
-flags(),
-buffer(buffer)
-{
-    flags.set(0, isEmpty);
-    flags.set(1);
-    flags.set(2, isEnd);
-}
-
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst>::reference RB::RingBuffer<T>::Iterator<IsConst>::operator *()
+template <typename T, typename Allocator>
+template <typename U, typename>
+void RB::RingBuffer<T, Allocator>::assignSlot(T& slot, U&& value)
 {
-    return buffer[index];
+    slot = std::forward<U>(value);
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst>& RB::RingBuffer<T>::Iterator<IsConst>::operator ++()
+template <typename T, typename Allocator>
+template <typename... Args>
+void RB::RingBuffer<T, Allocator>::assignSlot(T& slot, Args&&... args)
 {
-    index = (index + 1) % bufferSize;
-    if(index == w)
-    {
-        flags.set(2);
-    }
-    return *this;
+    slot = T(std::forward<Args>(args)...);
 }
 
-template <typename T>
-template <bool IsConst>
-bool RB::RingBuffer<T>::Iterator<IsConst>::operator ==(const Iterator& other) const
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::isFull() const
 {
-    return (flags.test(2) && other.flags.test(2))
-        || (index == other.index
-            && !flags.test(2) && !other.flags.test(2));
+    return (!isEmpty && r == w) || bufferSize == 0;
 }
 
-template <typename T>
-template <bool IsConst>
-bool RB::RingBuffer<T>::Iterator<IsConst>::operator !=(const Iterator& other) const
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::mustGrow() const
 {
-    return !(*this == other);
+    return isFull() && growthPolicy_factor > 1;
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst>::pointer RB::RingBuffer<T>::Iterator<IsConst>::operator ->()
+template <typename T, typename Allocator>
+bool RB::RingBuffer<T, Allocator>::canPush() const
 {
-    return &(buffer[index]);
+    return !isFull()
+        || growthPolicy_factor > 1
+        || (overwritePolicy_overwriteOldest && bufferSize != 0);
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst> RB::RingBuffer<T>::Iterator<IsConst>::operator ++(int)
+template <typename T, typename Allocator>
+std::size_t RB::RingBuffer<T, Allocator>::grownCapacity(std::size_t minimum) const
 {
-    Iterator copy = *this;
-    ++(*this);
-    return copy;
+    const std::size_t grown = static_cast<std::size_t>(std::ceil(bufferSize * growthPolicy_factor));
+    return grown > minimum ? grown : minimum;
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst>& RB::RingBuffer<T>::Iterator<IsConst>::operator --()
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::shrinkIfSparse()
 {
-    if(flags.test(2))
+    // without growth, a shrunk RingBuffer could not hold its capacity again
+    if(growthPolicy_factor <= 1)
+    {
+        return;
+    }
+
+    const std::size_t size = getSize();
+    if(size < bufferSize * shrinkPolicy_threshold)
     {
-        if(w == 0)
+        std::size_t shrunk = static_cast<std::size_t>(std::ceil(size * growthPolicy_factor));
+        shrunk = shrunk > 1 ? shrunk : 1;
+        if(shrunk < bufferSize)
         {
-            index = bufferSize - 1;
+            changeCapacity(shrunk);
         }
-        else
+    }
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::checkPop() const
+{
+#ifndef RING_BUFFER_UNCHECKED
+    if(isEmpty)
+    {
+        RING_BUFFER_THROW(std::out_of_range("RingBuffer is empty, cannot pop!"));
+    }
+#endif
+}
+
+template <typename T, typename Allocator>
+template <typename InputIt>
+std::size_t RB::RingBuffer<T, Allocator>::pushRange(InputIt first, InputIt last, std::input_iterator_tag)
+{
+    // single pass, the length isn't known up front
+    std::size_t dropped = 0;
+    for(; first != last; ++first)
+    {
+        if(push(*first))
         {
-            index = w - 1;
+            ++dropped;
         }
+    }
+    return dropped;
+}
+
+template <typename T, typename Allocator>
+template <typename ForwardIt>
+std::size_t RB::RingBuffer<T, Allocator>::pushRange(ForwardIt first, ForwardIt last, std::forward_iterator_tag)
+{
+    std::size_t count = std::distance(first, last);
+    if(count == 0)
+    {
+        return 0;
+    }
 
-        flags.reset(2);
+    std::size_t dropped = 0;
+    const std::size_t available = bufferSize - getSize();
+    if(count > available && growthPolicy_factor > 1)
+    {
+        changeCapacity(grownCapacity(getSize() + count));
     }
-    else
+    else if(count > available)
     {
-        if(index == 0)
+        if(!overwritePolicy_overwriteOldest || bufferSize == 0)
         {
-            index = bufferSize - 1;
+            RING_BUFFER_THROW(std::out_of_range("RingBuffer does not have enough space, cannot push!"));
         }
-        else
+        if(count > bufferSize)
+        {
+            // only the last bufferSize elements of the range would remain
+            dropped = count - bufferSize;
+            std::advance(first, dropped);
+            count = bufferSize;
+        }
+        if(count > available)
         {
-            --index;
+            // not discard(), which could shrink the capacity. The new elements
+            // go into the evicted slots, so those are destroyed first
+            const std::size_t evicted = count - available;
+            destroyElements(r, evicted, std::is_trivially_destructible<T>());
+            r = wrapIndex(r + evicted);
+            if(r == w)
+            {
+                isEmpty = true;
+            }
+            dropped += evicted;
         }
     }
 
-    return *this;
+    const std::size_t firstCount = std::min(count, bufferSize - w);
+    first = constructAtW(first, firstCount, CanMemcpy<ForwardIt>());
+    if(firstCount != count)
+    {
+        // w has wrapped to the start of the buffer, saying so explicitly also
+        // keeps GCC's -Warray-bounds from assuming w could be past the end
+        w = 0;
+        constructAtW(first, count - firstCount, CanMemcpy<ForwardIt>());
+    }
+    return dropped;
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst> RB::RingBuffer<T>::Iterator<IsConst>::operator --(int)
+template <typename T, typename Allocator>
+template <typename ForwardIt>
+ForwardIt RB::RingBuffer<T, Allocator>::constructAtW(ForwardIt first, std::size_t n, std::true_type)
 {
-    Iterator copy = *this;
-    --(*this);
-    return copy;
+    if(n != 0)
+    {
+        std::memcpy(buffer + w, first, n * sizeof(T));
+        w = wrapIndex(w + n);
+        isEmpty = false;
+    }
+    return first + n;
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst>& RB::RingBuffer<T>::Iterator<IsConst>::operator +=(const Iterator::difference_type& n)
+template <typename T, typename Allocator>
+template <typename ForwardIt>
+ForwardIt RB::RingBuffer<T, Allocator>::constructAtW(ForwardIt first, std::size_t n, std::false_type)
 {
-    difference_type m = n;
-    if(m >= 0)
+    // one element at a time so the state stays valid if a copy throws
+    for(std::size_t i = 0; i < n; ++i, ++first)
     {
-        while(m--)
-        {
-            ++(*this);
-        }
+        AllocatorTraits::construct(allocator, buffer + w, *first);
+        w = nextIndex(w);
+        isEmpty = false;
     }
-    else
+    return first;
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::fillAtW(const T& value, std::size_t n, std::true_type)
+{
+    if(n != 0)
     {
-        while(m++)
-        {
-            --(*this);
-        }
+        std::uninitialized_fill_n(buffer + w, n, value);
+        w = wrapIndex(w + n);
+        isEmpty = false;
     }
-
-    return *this;
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst> RB::RingBuffer<T>::Iterator<IsConst>::operator +(const Iterator::difference_type& n)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::fillAtW(const T& value, std::size_t n, std::false_type)
 {
-    Iterator copy = *this;
-    return copy += n;
+    // one element at a time so the state stays valid if a copy throws
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        AllocatorTraits::construct(allocator, buffer + w, value);
+        w = nextIndex(w);
+        isEmpty = false;
+    }
 }
 
-// only enable for ContainerType == RB::RingBuffer<T>
-template <
-    typename IteratorType,
-    typename ContainerType = typename IteratorType::parent_type,
-    typename T = typename ContainerType::value_type,
-    typename = std::enable_if_t<std::is_same<ContainerType, RB::RingBuffer<T>>::value>
->
-IteratorType operator +(const typename IteratorType::difference_type& n, const IteratorType& iter)
+template <typename T, typename Allocator>
+template <typename OutputIt>
+OutputIt RB::RingBuffer<T, Allocator>::moveFromR(OutputIt out, std::size_t n, std::true_type)
 {
-    IteratorType copy = iter;
-    return copy += n;
+    if(n != 0)
+    {
+        std::memcpy(out, buffer + r, n * sizeof(T));
+        r = wrapIndex(r + n);
+    }
+    return out + n;
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst>& RB::RingBuffer<T>::Iterator<IsConst>::operator -=(const Iterator::difference_type& n)
+template <typename T, typename Allocator>
+template <typename OutputIt>
+OutputIt RB::RingBuffer<T, Allocator>::moveFromR(OutputIt out, std::size_t n, std::false_type)
 {
-    return (*this) += -n;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        *out = std::move(buffer[r]);
+        ++out;
+        AllocatorTraits::destroy(allocator, buffer + r);
+        r = nextIndex(r);
+    }
+    return out;
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst> RB::RingBuffer<T>::Iterator<IsConst>::operator -(const Iterator::difference_type& n)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::destroyElements(std::size_t, std::size_t, std::true_type)
 {
-    Iterator copy = *this;
-    return copy -= n;
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst>::difference_type RB::RingBuffer<T>::Iterator<IsConst>::operator -(const Iterator& other)
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::destroyElements(std::size_t first, std::size_t n, std::false_type)
 {
-    if(flags.test(2) && other.flags.test(2))
+    for(std::size_t i = 0; i < n; ++i)
     {
-        return 0;
+        AllocatorTraits::destroy(allocator, buffer + first);
+        first = nextIndex(first);
     }
-    else if(flags.test(2))
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::relocateTo(T* newBuffer, std::size_t first, std::size_t n, std::true_type)
+{
+    if(n != 0)
     {
-        if(w >= other.index)
+        // at most two runs, split where the old storage wraps
+        const std::size_t start = wrapIndex(r + first);
+        const std::size_t firstRun = n < bufferSize - start ? n : bufferSize - start;
+        std::memcpy(newBuffer, buffer + start, firstRun * sizeof(T));
+        if(firstRun != n)
         {
-            return w - other.index;
-        }
-        else
-        {
-            return w + other.bufferSize - other.index;
+            std::memcpy(newBuffer + firstRun, buffer, (n - firstRun) * sizeof(T));
         }
     }
-    else if(!flags.test(2) && !other.flags.test(2))
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::relocateTo(T* newBuffer, std::size_t first, std::size_t n, std::false_type)
+{
+    std::size_t i = 0;
+    RING_BUFFER_TRY
     {
-        if(index >= other.index)
+        for(; i < n; ++i)
         {
-            return index - other.index;
-        }
-        else
-        {
-            return index + other.bufferSize - other.index;
+            // copies instead if moving could throw, so the old elements stay valid
+            AllocatorTraits::construct(allocator, newBuffer + i, std::move_if_noexcept(buffer[wrapIndex(r + first + i)]));
         }
     }
-    else
+    RING_BUFFER_CATCH_ALL
     {
-        // invalid condition
-        return 0;
+        for(std::size_t j = 0; j < i; ++j)
+        {
+            AllocatorTraits::destroy(allocator, newBuffer + j);
+        }
+        RING_BUFFER_RETHROW;
     }
 }
 
-template <typename T>
-template <bool IsConst>
-typename RB::RingBuffer<T>::template Iterator<IsConst>::reference RB::RingBuffer<T>::Iterator<IsConst>::operator [](const Iterator::difference_type& n)
+template <typename T, typename Allocator>
+T* RB::RingBuffer<T, Allocator>::allocate(std::size_t capacity)
 {
-    return *(*this + n);
+    return AllocatorTraits::allocate(allocator, capacity);
 }
 
-template <typename T>
-template <bool IsConst>
-bool RB::RingBuffer<T>::Iterator<IsConst>::operator <(const Iterator& other) const
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::deallocate(T* buffer, std::size_t capacity)
 {
-    if(flags.test(2))
+    if(buffer)
     {
-        return false;
-    }
-    else if(other.flags.test(2))
-    {
-        return true;
+        AllocatorTraits::deallocate(allocator, buffer, capacity);
     }
-    else
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::copyAllocator(const Allocator& other, std::true_type)
+{
+    allocator = other;
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::copyAllocator(const Allocator&, std::false_type)
+{
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::moveAllocator(Allocator& other, std::true_type)
+{
+    allocator = std::move(other);
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::moveAllocator(Allocator&, std::false_type)
+{
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::swapAllocator(Allocator& other, std::true_type)
+{
+    using std::swap;
+    swap(allocator, other);
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::swapAllocator(Allocator&, std::false_type)
+{
+}
+
+template <typename T, typename Allocator>
+std::size_t RB::RingBuffer<T, Allocator>::nextIndex(std::size_t index) const
+{
+    return index + 1 == bufferSize ? 0 : index + 1;
+}
+
+template <typename T, typename Allocator>
+std::size_t RB::RingBuffer<T, Allocator>::prevIndex(std::size_t index) const
+{
+    return index == 0 ? bufferSize - 1 : index - 1;
+}
+
+template <typename T, typename Allocator>
+std::size_t RB::RingBuffer<T, Allocator>::wrapIndex(std::size_t index) const
+{
+    // callers pass less than 2 * bufferSize, so one subtraction is enough
+    return index >= bufferSize ? index - bufferSize : index;
+}
+
+template <typename T, typename Allocator>
+void RB::RingBuffer<T, Allocator>::copyRingBuffer(const RB::RingBuffer<T, Allocator>& other)
+{
+    clear();
+    resizePolicy_preserveFront = other.resizePolicy_preserveFront;
+    overwritePolicy_overwriteOldest = other.overwritePolicy_overwriteOldest;
+    growthPolicy_factor = other.growthPolicy_factor;
+    shrinkPolicy_threshold = other.shrinkPolicy_threshold;
+    if(bufferSize != other.bufferSize)
     {
-        if(index >= r && other.index >= other.r)
-        {
-            return index < other.index;
-        }
-        else if(index >= r && other.index < other.r)
-        {
-            return true;
-        }
-        else if(index < r && other.index >= other.r)
+        deallocate(buffer, bufferSize);
+        buffer = nullptr;
+        bufferSize = 0;
+        if(other.bufferSize != 0)
         {
-            return false;
+            buffer = allocate(other.bufferSize);
+            bufferSize = other.bufferSize;
         }
-        else //if(index < r && other.index < other.r)
+    }
+    if(other.buffer && !other.isEmpty)
+    {
+        // a full buffer has other.r == other.w, so count by size
+        const std::size_t size = other.getSize();
+        for(std::size_t i = 0; i < size; ++i)
         {
-            return index < other.index;
+            AllocatorTraits::construct(allocator, buffer + i, other.buffer[wrapIndex(other.r + i)]);
+            // keep the state valid in case the next copy throws
+            isEmpty = false;
+            w = wrapIndex(i + 1);
         }
     }
 }
 
-template <typename T>
+template <typename T, typename Allocator>
+template <bool IsConst>
+RB::RingBuffer<T, Allocator>::Iterator<IsConst>::Iterator() :
+parent(nullptr),
+position(0)
+{
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+RB::RingBuffer<T, Allocator>::Iterator<IsConst>::Iterator(parent_type* parent, std::size_t position) :
+parent(parent),
+position(position)
+{
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst>::reference RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator *() const
+{
+    return (*parent)[position];
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst>::pointer RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator ->() const
+{
+    return &(*parent)[position];
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst>::reference RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator [](const difference_type& n) const
+{
+    return (*parent)[position + n];
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst>& RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator ++()
+{
+    ++position;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst> RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator ++(int)
+{
+    Iterator copy = *this;
+    ++position;
+    return copy;
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst>& RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator --()
+{
+    --position;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst> RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator --(int)
+{
+    Iterator copy = *this;
+    --position;
+    return copy;
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst>& RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator +=(const difference_type& n)
+{
+    position += n;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst> RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator +(const difference_type& n) const
+{
+    return Iterator(parent, position + n);
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst>& RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator -=(const difference_type& n)
+{
+    position -= n;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst> RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator -(const difference_type& n) const
+{
+    return Iterator(parent, position - n);
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+typename RB::RingBuffer<T, Allocator>::template Iterator<IsConst>::difference_type RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator -(const Iterator& other) const
+{
+    return (difference_type)position - (difference_type)other.position;
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+bool RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator ==(const Iterator& other) const
+{
+    return position == other.position;
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+bool RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator !=(const Iterator& other) const
+{
+    return position != other.position;
+}
+
+template <typename T, typename Allocator>
+template <bool IsConst>
+bool RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator <(const Iterator& other) const
+{
+    return position < other.position;
+}
+
+template <typename T, typename Allocator>
 template <bool IsConst>
-bool RB::RingBuffer<T>::Iterator<IsConst>::operator >(const Iterator& other) const
+bool RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator >(const Iterator& other) const
 {
-    return other < *this;
+    return position > other.position;
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <bool IsConst>
-bool RB::RingBuffer<T>::Iterator<IsConst>::operator >=(const Iterator& other) const
+bool RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator >=(const Iterator& other) const
 {
-    return !(*this < other);
+    return position >= other.position;
 }
 
-template <typename T>
+template <typename T, typename Allocator>
 template <bool IsConst>
-bool RB::RingBuffer<T>::Iterator<IsConst>::operator <=(const Iterator& other) const
+bool RB::RingBuffer<T, Allocator>::Iterator<IsConst>::operator <=(const Iterator& other) const
 {
-    return !(*this > other);
+    return position <= other.position;
 }
 
-template <typename T>
-typename RB::RingBuffer<T>::template Iterator<false> RB::RingBuffer<T>::begin()
+template <typename T, typename Allocator>
+typename RB::RingBuffer<T, Allocator>::template Iterator<false> RB::RingBuffer<T, Allocator>::begin()
 {
-    return Iterator<false>(r, w, bufferSize, r, isEmpty, isEmpty, buffer.get());
+    return Iterator<false>(this, 0);
 }
 
-template <typename T>
-typename RB::RingBuffer<T>::template Iterator<false> RB::RingBuffer<T>::end()
+template <typename T, typename Allocator>
+typename RB::RingBuffer<T, Allocator>::template Iterator<false> RB::RingBuffer<T, Allocator>::end()
 {
-    return Iterator<false>(r, w, bufferSize, r, isEmpty, true, buffer.get());
+    return Iterator<false>(this, getSize());
 }
 
-template <typename T>
-typename RB::RingBuffer<T>::template Iterator<true> RB::RingBuffer<T>::begin() const
+template <typename T, typename Allocator>
+typename RB::RingBuffer<T, Allocator>::template Iterator<true> RB::RingBuffer<T, Allocator>::begin() const
 {
     return cbegin();
 }
 
-template <typename T>
-typename RB::RingBuffer<T>::template Iterator<true> RB::RingBuffer<T>::end() const
+template <typename T, typename Allocator>
+typename RB::RingBuffer<T, Allocator>::template Iterator<true> RB::RingBuffer<T, Allocator>::end() const
 {
     return cend();
 }
 
-template <typename T>
-typename RB::RingBuffer<T>::template Iterator<true> RB::RingBuffer<T>::cbegin() const
+template <typename T, typename Allocator>
+typename RB::RingBuffer<T, Allocator>::template Iterator<true> RB::RingBuffer<T, Allocator>::cbegin() const
 {
-    return Iterator<true>(r, w, bufferSize, r, isEmpty, isEmpty, buffer.get());
+    return Iterator<true>(this, 0);
 }
 
-template <typename T>
-typename RB::RingBuffer<T>::template Iterator<true> RB::RingBuffer<T>::cend() const
+template <typename T, typename Allocator>
+typename RB::RingBuffer<T, Allocator>::template Iterator<true> RB::RingBuffer<T, Allocator>::cend() const
 {
-    return Iterator<true>(r, w, bufferSize, r, isEmpty, true, buffer.get());
+    return Iterator<true>(this, getSize());
 }
@@ -0,0 +1,135 @@
+#ifndef SPSC_RING_BUFFER_HPP
+#define SPSC_RING_BUFFER_HPP
+
+#ifndef RING_BUFFER_DEFAULT_CAPACITY
+  #define RING_BUFFER_DEFAULT_CAPACITY 32
+#endif
+
+#ifndef RING_BUFFER_CACHE_LINE_SIZE
+  #define RING_BUFFER_CACHE_LINE_SIZE 64
+#endif
+
+#include <cstdlib>
+#include <cstddef>
+
+#include <memory>
+#include <atomic>
+#include <array>
+#include <type_traits>
+
+namespace RB
+{
+
+/*!
+ * A lock-free RingBuffer that may be shared between exactly one producer
+ * thread and exactly one consumer thread.
+ *
+ * push/try_push/claim/commit may only be called by the producer, and
+ * top/pop/try_pop/readClaim/release may only be called by the consumer.
+ * getSize and empty may be called by either thread, but the result may
+ * already be stale by the time it is returned.
+ *
+ * The read and write indices live on separate cache lines and are published
+ * with release stores and observed with acquire loads, so no lock or shared
+ * "isEmpty" flag is needed. One extra slot is allocated so that a full buffer
+ * can be told apart from an empty one by the indices alone.
+ *
+ * Every slot holds a T for the lifetime of the buffer, so that claim() can
+ * hand out slots to write in place, which requires T to be default
+ * constructible. Popped slots are reset to T() before the producer may reuse
+ * them, so a popped std::shared_ptr or std::string releases its resource
+ * right away (trivially destructible types are left as they are).
+ */
+template <typename T>
+class SPSCRingBuffer
+{
+public:
+    typedef T value_type;
+
+    SPSCRingBuffer(std::size_t capacity = RING_BUFFER_DEFAULT_CAPACITY);
+
+    // no copy or move, the other thread may be using the buffer
+    SPSCRingBuffer(const SPSCRingBuffer<T>& other) = delete;
+    SPSCRingBuffer<T>& operator=(const SPSCRingBuffer<T>& other) = delete;
+
+    struct Span
+    {
+        T* data;
+        std::size_t size;
+    };
+
+    // producer
+    void push(const T& reference);
+    void push(T&& r_value);
+    bool try_push(const T& reference);
+    bool try_push(T&& r_value);
+
+    /*!
+     * Returns up to n unused slots as at most two contiguous runs, in order,
+     * fewer if the buffer does not have n free. The slots hold valid T
+     * objects that may be written in place, and are only seen by the consumer
+     * once commit() publishes them.
+     */
+    std::array<Span, 2> claim(std::size_t n);
+
+    /*!
+     * Publishes the first n slots returned by claim(). Throws
+     * std::out_of_range if fewer than n slots were free.
+     */
+    void commit(std::size_t n);
+
+    // consumer
+    void pop();
+    T& top();
+    bool try_pop(T& out);
+
+    /*!
+     * Returns up to n of the oldest elements as at most two contiguous runs,
+     * in order, fewer if there are not n elements. They stay in the buffer, so
+     * they can be processed in place, until release() pops them.
+     */
+    std::array<Span, 2> readClaim(std::size_t n);
+
+    /*!
+     * Pops the first n elements returned by readClaim(). Throws
+     * std::out_of_range if there were fewer than n elements.
+     */
+    void release(std::size_t n);
+
+    bool empty() const;
+    std::size_t getCapacity() const;
+    std::size_t getSize() const;
+
+private:
+    const std::size_t bufferSize;
+    std::unique_ptr<T[]> buffer;
+
+    // owned by the consumer
+    alignas(RING_BUFFER_CACHE_LINE_SIZE) std::atomic<std::size_t> r;
+    std::size_t cachedW;
+
+    // owned by the producer
+    alignas(RING_BUFFER_CACHE_LINE_SIZE) std::atomic<std::size_t> w;
+    std::size_t cachedR;
+
+    std::size_t next(std::size_t index) const;
+    std::size_t wrap(std::size_t index) const;
+    // free slots and elements as seen through the cached indices
+    std::size_t freeSlots(std::size_t currentW) const;
+    std::size_t usedSlots(std::size_t currentR) const;
+    // splits n slots starting at index where the storage wraps
+    std::array<Span, 2> spans(std::size_t index, std::size_t n) const;
+    bool checkPush(std::size_t nextW);
+    bool checkPop(std::size_t currentR);
+    // resets popped slots, so they do not keep resources alive
+    void resetSlots(std::size_t index, std::size_t n);
+    void resetSlots(std::size_t index, std::size_t n, std::true_type);
+    void resetSlots(std::size_t index, std::size_t n, std::false_type);
+
+};
+
+} // namespace RB
+
+#include "SPSCRingBuffer.inl"
+
+#endif
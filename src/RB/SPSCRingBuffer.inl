@@ -0,0 +1,259 @@
+
+#include <stdexcept>
+#include <algorithm>
+
+#include "Error.hpp"
+
+template <typename T>
+RB::SPSCRingBuffer<T>::SPSCRingBuffer(std::size_t capacity) :
+bufferSize(capacity + 1),
+buffer(std::make_unique<T[]>(capacity + 1)),
+r(0),
+cachedW(0),
+w(0),
+cachedR(0)
+{
+}
+
+template <typename T>
+void RB::SPSCRingBuffer<T>::push(const T& reference)
+{
+    if(!try_push(reference))
+    {
+        RING_BUFFER_THROW(std::out_of_range("SPSCRingBuffer max capacity reached, cannot push!"));
+    }
+}
+
+template <typename T>
+void RB::SPSCRingBuffer<T>::push(T&& r_value)
+{
+    if(!try_push(std::forward<T>(r_value)))
+    {
+        RING_BUFFER_THROW(std::out_of_range("SPSCRingBuffer max capacity reached, cannot push!"));
+    }
+}
+
+template <typename T>
+bool RB::SPSCRingBuffer<T>::try_push(const T& reference)
+{
+    const std::size_t currentW = w.load(std::memory_order_relaxed);
+    const std::size_t nextW = next(currentW);
+    if(!checkPush(nextW))
+    {
+        return false;
+    }
+
+    buffer[currentW] = reference;
+    w.store(nextW, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool RB::SPSCRingBuffer<T>::try_push(T&& r_value)
+{
+    const std::size_t currentW = w.load(std::memory_order_relaxed);
+    const std::size_t nextW = next(currentW);
+    if(!checkPush(nextW))
+    {
+        return false;
+    }
+
+    buffer[currentW] = std::forward<T>(r_value);
+    w.store(nextW, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+std::array<typename RB::SPSCRingBuffer<T>::Span, 2> RB::SPSCRingBuffer<T>::claim(std::size_t n)
+{
+    const std::size_t currentW = w.load(std::memory_order_relaxed);
+    if(freeSlots(currentW) < n)
+    {
+        cachedR = r.load(std::memory_order_acquire);
+    }
+    return spans(currentW, std::min(n, freeSlots(currentW)));
+}
+
+template <typename T>
+void RB::SPSCRingBuffer<T>::commit(std::size_t n)
+{
+    const std::size_t currentW = w.load(std::memory_order_relaxed);
+    // claim() refreshed cachedR, so it covers every slot claimed
+    if(n > freeSlots(currentW))
+    {
+        RING_BUFFER_THROW(std::out_of_range("SPSCRingBuffer does not have enough space, cannot commit!"));
+    }
+
+    w.store(wrap(currentW + n), std::memory_order_release);
+}
+
+template <typename T>
+void RB::SPSCRingBuffer<T>::pop()
+{
+    const std::size_t currentR = r.load(std::memory_order_relaxed);
+    if(!checkPop(currentR))
+    {
+        RING_BUFFER_THROW(std::out_of_range("SPSCRingBuffer is empty, cannot pop!"));
+    }
+
+    resetSlots(currentR, 1);
+    r.store(next(currentR), std::memory_order_release);
+}
+
+template <typename T>
+T& RB::SPSCRingBuffer<T>::top()
+{
+    return buffer[r.load(std::memory_order_relaxed)];
+}
+
+template <typename T>
+bool RB::SPSCRingBuffer<T>::try_pop(T& out)
+{
+    const std::size_t currentR = r.load(std::memory_order_relaxed);
+    if(!checkPop(currentR))
+    {
+        return false;
+    }
+
+    out = std::move(buffer[currentR]);
+    resetSlots(currentR, 1);
+    r.store(next(currentR), std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+std::array<typename RB::SPSCRingBuffer<T>::Span, 2> RB::SPSCRingBuffer<T>::readClaim(std::size_t n)
+{
+    const std::size_t currentR = r.load(std::memory_order_relaxed);
+    if(usedSlots(currentR) < n)
+    {
+        cachedW = w.load(std::memory_order_acquire);
+    }
+    return spans(currentR, std::min(n, usedSlots(currentR)));
+}
+
+template <typename T>
+void RB::SPSCRingBuffer<T>::release(std::size_t n)
+{
+    const std::size_t currentR = r.load(std::memory_order_relaxed);
+    // readClaim() refreshed cachedW, so it covers every element claimed
+    if(n > usedSlots(currentR))
+    {
+        RING_BUFFER_THROW(std::out_of_range("SPSCRingBuffer has too few elements, cannot release!"));
+    }
+
+    resetSlots(currentR, n);
+    r.store(wrap(currentR + n), std::memory_order_release);
+}
+
+template <typename T>
+bool RB::SPSCRingBuffer<T>::empty() const
+{
+    return r.load(std::memory_order_acquire)
+        == w.load(std::memory_order_acquire);
+}
+
+template <typename T>
+std::size_t RB::SPSCRingBuffer<T>::getCapacity() const
+{
+    return bufferSize - 1;
+}
+
+template <typename T>
+std::size_t RB::SPSCRingBuffer<T>::getSize() const
+{
+    const std::size_t currentR = r.load(std::memory_order_acquire);
+    const std::size_t currentW = w.load(std::memory_order_acquire);
+    return currentR <= currentW
+        ? currentW - currentR
+        : bufferSize - currentR + currentW;
+}
+
+template <typename T>
+std::size_t RB::SPSCRingBuffer<T>::next(std::size_t index) const
+{
+    ++index;
+    return index == bufferSize ? 0 : index;
+}
+
+template <typename T>
+std::size_t RB::SPSCRingBuffer<T>::wrap(std::size_t index) const
+{
+    return index >= bufferSize ? index - bufferSize : index;
+}
+
+template <typename T>
+std::size_t RB::SPSCRingBuffer<T>::freeSlots(std::size_t currentW) const
+{
+    // one slot always stays empty
+    return cachedR > currentW
+        ? cachedR - currentW - 1
+        : bufferSize - currentW + cachedR - 1;
+}
+
+template <typename T>
+std::size_t RB::SPSCRingBuffer<T>::usedSlots(std::size_t currentR) const
+{
+    return cachedW >= currentR
+        ? cachedW - currentR
+        : bufferSize - currentR + cachedW;
+}
+
+template <typename T>
+std::array<typename RB::SPSCRingBuffer<T>::Span, 2> RB::SPSCRingBuffer<T>::spans(std::size_t index, std::size_t n) const
+{
+    const std::size_t firstCount = std::min(n, bufferSize - index);
+    return {{{buffer.get() + index, firstCount}, {buffer.get(), n - firstCount}}};
+}
+
+template <typename T>
+bool RB::SPSCRingBuffer<T>::checkPush(std::size_t nextW)
+{
+    if(nextW == cachedR)
+    {
+        // only go to the consumer's cache line when the cached index says full
+        cachedR = r.load(std::memory_order_acquire);
+        if(nextW == cachedR)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool RB::SPSCRingBuffer<T>::checkPop(std::size_t currentR)
+{
+    if(currentR == cachedW)
+    {
+        // only go to the producer's cache line when the cached index says empty
+        cachedW = w.load(std::memory_order_acquire);
+        if(currentR == cachedW)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void RB::SPSCRingBuffer<T>::resetSlots(std::size_t index, std::size_t n)
+{
+    // the slots still belong to the consumer until r is published
+    resetSlots(index, n, typename std::is_trivially_destructible<T>::type());
+}
+
+template <typename T>
+void RB::SPSCRingBuffer<T>::resetSlots(std::size_t, std::size_t, std::true_type)
+{
+}
+
+template <typename T>
+void RB::SPSCRingBuffer<T>::resetSlots(std::size_t index, std::size_t n, std::false_type)
+{
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        buffer[index] = T();
+        index = next(index);
+    }
+}
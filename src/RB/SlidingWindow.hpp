@@ -0,0 +1,191 @@
+#ifndef SLIDING_WINDOW_HPP
+#define SLIDING_WINDOW_HPP
+
+#ifndef RING_BUFFER_DEFAULT_CAPACITY
+  #define RING_BUFFER_DEFAULT_CAPACITY 32
+#endif
+
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <type_traits>
+
+#include "RingBuffer.hpp"
+
+namespace RB
+{
+
+/*!
+ * The last "window size" samples pushed, with their sum, mean, minimum and
+ * maximum kept up to date as samples enter and leave the window, so every
+ * query is O(1) whatever the window size.
+ *
+ * Once the window is full, each push evicts the oldest sample. The sum is a
+ * running sum; for floating point samples it carries a Neumaier compensation
+ * term, so adding and removing samples for a long time does not drift (as
+ * long as the code is not compiled with -ffast-math, which removes it). The
+ * minimum and maximum come from two monotonic deques, RingBuffers of the
+ * samples that may still become the minimum (or maximum) before they leave,
+ * so a push is amortized O(1).
+ *
+ * T must be copyable and ordered with operator<, and for the sum and mean
+ * support + and -.
+ */
+template <typename T>
+class SlidingWindow
+{
+public:
+    typedef T value_type;
+
+    /*!
+     * Throws std::out_of_range on push if windowSize is 0.
+     */
+    SlidingWindow(std::size_t windowSize = RING_BUFFER_DEFAULT_CAPACITY);
+
+    /*!
+     * Adds sample to the window. Returns true if the window was full and
+     * its oldest sample was evicted to make room.
+     */
+    bool push(const T& sample);
+
+    /*!
+     * Evicts the oldest sample, for windows bounded by time rather than by
+     * count. Throws std::out_of_range if the window is empty.
+     */
+    void pop();
+    void clear();
+
+    /*!
+     * The sum of the samples in the window, T() when empty.
+     */
+    T getSum() const;
+
+    /*!
+     * getSum() / getSize(), NaN when empty.
+     */
+    double getMean() const;
+
+    /*!
+     * Undefined when the window is empty, like RingBuffer::top().
+     */
+    const T& getMin() const;
+    const T& getMax() const;
+
+    /*!
+     * The samples in the window, oldest first.
+     */
+    const RingBuffer<T>& getSamples() const;
+
+    bool empty() const;
+    std::size_t getWindowSize() const;
+    std::size_t getSize() const;
+
+private:
+    struct Entry
+    {
+        T value;
+        std::uint64_t index;
+    };
+
+    /*!
+     * The samples that may still be the first in Compare order before they
+     * leave the window, in the order they were pushed. Their values are
+     * strictly increasing in Compare order, so the front is the answer.
+     */
+    template <typename Compare>
+    struct MonotonicDeque
+    {
+        RingBuffer<Entry> entries;
+
+        MonotonicDeque(std::size_t windowSize);
+        void push(const T& sample, std::uint64_t index);
+        void evict(std::uint64_t index);
+    };
+
+    RingBuffer<T> samples;
+    // number of samples pushed since the last clear, the index of the next
+    std::uint64_t pushed;
+
+    T sum;
+    T compensation;
+
+    MonotonicDeque<std::less<T>> minimums;
+    MonotonicDeque<std::greater<T>> maximums;
+
+    void addToSum(const T& value, std::true_type isFloatingPoint);
+    void addToSum(const T& value, std::false_type isFloatingPoint);
+    void removeFromSum(const T& value, std::true_type isFloatingPoint);
+    void removeFromSum(const T& value, std::false_type isFloatingPoint);
+
+};
+
+/*!
+ * The last "window size" samples pushed, folded with an associative
+ * BinaryOperation (oldest first, so it does not have to be commutative) and
+ * kept up to date as samples enter and leave the window. get() is O(1) and
+ * push/pop are amortized O(1), with no inverse of the operation needed.
+ *
+ * This is two-stack aggregation over the window: the older samples (the
+ * front) keep their suffix aggregates, the newer ones (the back) their
+ * prefix aggregates, both in one RingBuffer, and get() combines the first
+ * suffix with the last prefix. When the front runs out, the back becomes the
+ * new front by recomputing its aggregates in place.
+ */
+template <typename T, typename BinaryOperation>
+class SlidingAggregate
+{
+public:
+    typedef T value_type;
+
+    /*!
+     * Throws std::out_of_range on push if windowSize is 0.
+     */
+    SlidingAggregate(std::size_t windowSize = RING_BUFFER_DEFAULT_CAPACITY,
+        BinaryOperation operation = BinaryOperation());
+
+    /*!
+     * Same as SlidingWindow::push, returns true if the oldest sample was
+     * evicted.
+     */
+    bool push(const T& sample);
+
+    /*!
+     * Throws std::out_of_range if the window is empty.
+     */
+    void pop();
+    void clear();
+
+    /*!
+     * operation applied over every sample in the window, oldest first.
+     * Undefined when the window is empty.
+     */
+    T get() const;
+
+    /*!
+     * The samples in the window, oldest first.
+     */
+    const RingBuffer<T>& getSamples() const;
+
+    bool empty() const;
+    std::size_t getWindowSize() const;
+    std::size_t getSize() const;
+
+private:
+    RingBuffer<T> samples;
+    // aggregates[i] folds samples [i, frontSize) for i < frontSize, and
+    // samples [frontSize, i] after that
+    RingBuffer<T> aggregates;
+    std::size_t frontSize;
+    BinaryOperation operation;
+
+    void flip();
+
+};
+
+} // namespace RB
+
+#include "SlidingWindow.inl"
+
+#endif
@@ -0,0 +1,303 @@
+
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+
+#include "Error.hpp"
+
+template <typename T>
+template <typename Compare>
+RB::SlidingWindow<T>::MonotonicDeque<Compare>::MonotonicDeque(std::size_t windowSize) :
+entries(windowSize)
+{
+}
+
+template <typename T>
+template <typename Compare>
+void RB::SlidingWindow<T>::MonotonicDeque<Compare>::push(const T& sample, std::uint64_t index)
+{
+    // samples that are not before the new one can never be the answer again,
+    // the new one leaves the window after them
+    Compare compare;
+    while(!entries.empty() && !compare(entries.back().value, sample))
+    {
+        entries.pop_back();
+    }
+    entries.push(Entry{sample, index});
+}
+
+template <typename T>
+template <typename Compare>
+void RB::SlidingWindow<T>::MonotonicDeque<Compare>::evict(std::uint64_t index)
+{
+    if(!entries.empty() && entries.top().index == index)
+    {
+        entries.pop();
+    }
+}
+
+template <typename T>
+RB::SlidingWindow<T>::SlidingWindow(std::size_t windowSize) :
+samples(windowSize),
+pushed(0),
+sum(),
+compensation(),
+minimums(windowSize),
+maximums(windowSize)
+{
+}
+
+template <typename T>
+bool RB::SlidingWindow<T>::push(const T& sample)
+{
+    if(samples.getCapacity() == 0)
+    {
+        RING_BUFFER_THROW(std::out_of_range("SlidingWindow has a window size of 0, cannot push!"));
+    }
+
+    // evicting first keeps every RingBuffer within the window size
+    const bool evicted = samples.getSize() == samples.getCapacity();
+    if(evicted)
+    {
+        pop();
+    }
+
+    samples.push(sample);
+    addToSum(sample, std::is_floating_point<T>());
+    minimums.push(sample, pushed);
+    maximums.push(sample, pushed);
+    ++pushed;
+    return evicted;
+}
+
+template <typename T>
+void RB::SlidingWindow<T>::pop()
+{
+    if(samples.empty())
+    {
+        RING_BUFFER_THROW(std::out_of_range("SlidingWindow is empty, cannot pop!"));
+    }
+
+    const std::uint64_t oldest = pushed - samples.getSize();
+    removeFromSum(samples.top(), std::is_floating_point<T>());
+    minimums.evict(oldest);
+    maximums.evict(oldest);
+    samples.pop();
+
+    if(samples.empty())
+    {
+        // nothing left to sum, drop the rounding error left behind
+        sum = T();
+        compensation = T();
+    }
+}
+
+template <typename T>
+void RB::SlidingWindow<T>::clear()
+{
+    samples.clear();
+    minimums.entries.clear();
+    maximums.entries.clear();
+    pushed = 0;
+    sum = T();
+    compensation = T();
+}
+
+template <typename T>
+T RB::SlidingWindow<T>::getSum() const
+{
+    return sum + compensation;
+}
+
+template <typename T>
+double RB::SlidingWindow<T>::getMean() const
+{
+    if(samples.empty())
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return static_cast<double>(getSum()) / samples.getSize();
+}
+
+template <typename T>
+const T& RB::SlidingWindow<T>::getMin() const
+{
+    return minimums.entries[0].value;
+}
+
+template <typename T>
+const T& RB::SlidingWindow<T>::getMax() const
+{
+    return maximums.entries[0].value;
+}
+
+template <typename T>
+const RB::RingBuffer<T>& RB::SlidingWindow<T>::getSamples() const
+{
+    return samples;
+}
+
+template <typename T>
+bool RB::SlidingWindow<T>::empty() const
+{
+    return samples.empty();
+}
+
+template <typename T>
+std::size_t RB::SlidingWindow<T>::getWindowSize() const
+{
+    return samples.getCapacity();
+}
+
+template <typename T>
+std::size_t RB::SlidingWindow<T>::getSize() const
+{
+    return samples.getSize();
+}
+
+template <typename T>
+void RB::SlidingWindow<T>::addToSum(const T& value, std::true_type)
+{
+    // Neumaier: keep the low order bits lost by the addition in compensation
+    const T total = sum + value;
+    if(std::abs(sum) >= std::abs(value))
+    {
+        compensation += (sum - total) + value;
+    }
+    else
+    {
+        compensation += (value - total) + sum;
+    }
+    sum = total;
+}
+
+template <typename T>
+void RB::SlidingWindow<T>::addToSum(const T& value, std::false_type)
+{
+    sum += value;
+}
+
+template <typename T>
+void RB::SlidingWindow<T>::removeFromSum(const T& value, std::true_type isFloatingPoint)
+{
+    addToSum(-value, isFloatingPoint);
+}
+
+template <typename T>
+void RB::SlidingWindow<T>::removeFromSum(const T& value, std::false_type)
+{
+    sum -= value;
+}
+
+template <typename T, typename BinaryOperation>
+RB::SlidingAggregate<T, BinaryOperation>::SlidingAggregate(std::size_t windowSize, BinaryOperation operation) :
+samples(windowSize),
+aggregates(windowSize),
+frontSize(0),
+operation(operation)
+{
+}
+
+template <typename T, typename BinaryOperation>
+bool RB::SlidingAggregate<T, BinaryOperation>::push(const T& sample)
+{
+    if(samples.getCapacity() == 0)
+    {
+        RING_BUFFER_THROW(std::out_of_range("SlidingAggregate has a window size of 0, cannot push!"));
+    }
+
+    const bool evicted = samples.getSize() == samples.getCapacity();
+    if(evicted)
+    {
+        pop();
+    }
+
+    // extend the prefix aggregate of the back
+    if(samples.getSize() == frontSize)
+    {
+        aggregates.push(sample);
+    }
+    else
+    {
+        aggregates.push(operation(aggregates.back(), sample));
+    }
+    samples.push(sample);
+    return evicted;
+}
+
+template <typename T, typename BinaryOperation>
+void RB::SlidingAggregate<T, BinaryOperation>::pop()
+{
+    if(samples.empty())
+    {
+        RING_BUFFER_THROW(std::out_of_range("SlidingAggregate is empty, cannot pop!"));
+    }
+
+    if(frontSize == 0)
+    {
+        flip();
+    }
+    samples.pop();
+    aggregates.pop();
+    --frontSize;
+}
+
+template <typename T, typename BinaryOperation>
+void RB::SlidingAggregate<T, BinaryOperation>::clear()
+{
+    samples.clear();
+    aggregates.clear();
+    frontSize = 0;
+}
+
+template <typename T, typename BinaryOperation>
+T RB::SlidingAggregate<T, BinaryOperation>::get() const
+{
+    if(frontSize == 0)
+    {
+        return aggregates.back();
+    }
+    if(frontSize == samples.getSize())
+    {
+        return aggregates[0];
+    }
+    return operation(aggregates[0], aggregates.back());
+}
+
+template <typename T, typename BinaryOperation>
+const RB::RingBuffer<T>& RB::SlidingAggregate<T, BinaryOperation>::getSamples() const
+{
+    return samples;
+}
+
+template <typename T, typename BinaryOperation>
+bool RB::SlidingAggregate<T, BinaryOperation>::empty() const
+{
+    return samples.empty();
+}
+
+template <typename T, typename BinaryOperation>
+std::size_t RB::SlidingAggregate<T, BinaryOperation>::getWindowSize() const
+{
+    return samples.getCapacity();
+}
+
+template <typename T, typename BinaryOperation>
+std::size_t RB::SlidingAggregate<T, BinaryOperation>::getSize() const
+{
+    return samples.getSize();
+}
+
+template <typename T, typename BinaryOperation>
+void RB::SlidingAggregate<T, BinaryOperation>::flip()
+{
+    // every sample joins the front, so every aggregate becomes a suffix
+    // aggregate, each sample is flipped at most once between push and pop
+    const std::size_t size = samples.getSize();
+    aggregates[size - 1] = samples[size - 1];
+    for(std::size_t i = size - 1; i-- > 0;)
+    {
+        aggregates[i] = operation(samples[i], aggregates[i + 1]);
+    }
+    frontSize = size;
+}
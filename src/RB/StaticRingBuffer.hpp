@@ -0,0 +1,155 @@
+#ifndef STATIC_RING_BUFFER_HPP
+#define STATIC_RING_BUFFER_HPP
+
+#include <cstdlib>
+#include <cstddef>
+
+#include <iterator>
+#include <type_traits>
+
+namespace RB
+{
+
+/*!
+ * A RingBuffer with a capacity fixed at compile time and storage held inside
+ * the object, so it never allocates.
+ *
+ * Slots are left uninitialized until pushed to, and popped elements are
+ * destroyed right away, so T does not need to be default constructible. The
+ * object holds no pointers, so it may be placed on the stack, inside another
+ * struct, or in shared memory.
+ */
+template <typename T, std::size_t N>
+class StaticRingBuffer
+{
+    static_assert(N > 0, "StaticRingBuffer capacity must be greater than 0");
+
+public:
+    typedef T value_type;
+
+    StaticRingBuffer();
+    ~StaticRingBuffer();
+
+    // copy
+    StaticRingBuffer(const StaticRingBuffer<T, N>& other);
+    StaticRingBuffer<T, N>& operator=(const StaticRingBuffer<T, N>& other);
+
+    // move, element by element, the moved from StaticRingBuffer is left empty
+    StaticRingBuffer(StaticRingBuffer<T, N>&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+    StaticRingBuffer<T, N>& operator=(StaticRingBuffer<T, N>&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    /*!
+     * Returns true if the oldest element was overwritten to make room, which
+     * can only happen when the overwrite policy is set.
+     */
+    bool push(const T& reference);
+    bool push(T&& r_value);
+    void pop();
+    T& top();
+    const T& top() const;
+
+    /*!
+     * Unchecked, index must be less than getSize(). Use at() for a bounds
+     * checked access.
+     */
+    T& operator [](std::size_t index);
+    const T& operator [](std::size_t index) const;
+
+    T& at(std::size_t index);
+    const T& at(std::size_t index) const;
+
+    bool empty() const;
+    constexpr std::size_t getCapacity() const;
+    std::size_t getSize() const;
+
+    /*!
+     * Destroys all elements.
+     */
+    void clear();
+
+    /*!
+     * Same as RingBuffer::setOverwritePolicy, if set to true pushing to a full
+     * StaticRingBuffer overwrites the oldest element instead of throwing.
+     */
+    bool setOverwritePolicy(bool overwriteOldest);
+    bool getOverwritePolicy() const;
+
+private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[N];
+    std::size_t r;
+    std::size_t size;
+    bool overwritePolicy_overwriteOldest;
+
+    T* slot(std::size_t index);
+    const T* slot(std::size_t index) const;
+    void checkPush() const;
+    void checkPop() const;
+
+public:
+    template <bool IsConst>
+    class Iterator
+    {
+    public:
+        typedef std::ptrdiff_t difference_type;
+        typedef T value_type;
+        typedef std::conditional_t<IsConst, const T&, T&> reference;
+        typedef std::conditional_t<IsConst, const T*, T*> pointer;
+        typedef std::random_access_iterator_tag iterator_category;
+
+        typedef std::conditional_t<IsConst,
+            const StaticRingBuffer<T, N>,
+            StaticRingBuffer<T, N>> parent_type;
+
+        Iterator();
+        Iterator(parent_type* parent, std::size_t position);
+
+        reference operator *() const;
+        pointer operator ->() const;
+        reference operator [](const difference_type& n) const;
+
+        Iterator& operator ++();
+        Iterator operator ++(int);
+        Iterator& operator --();
+        Iterator operator --(int);
+
+        Iterator& operator +=(const difference_type& n);
+        Iterator operator +(const difference_type& n) const;
+        Iterator& operator -=(const difference_type& n);
+        Iterator operator -(const difference_type& n) const;
+        difference_type operator -(const Iterator& other) const;
+
+        friend Iterator operator +(const difference_type& n, const Iterator& iter)
+        {
+            return iter + n;
+        }
+
+        bool operator ==(const Iterator& other) const;
+        bool operator !=(const Iterator& other) const;
+        bool operator <(const Iterator& other) const;
+        bool operator >(const Iterator& other) const;
+        bool operator >=(const Iterator& other) const;
+        bool operator <=(const Iterator& other) const;
+
+    private:
+        parent_type* parent;
+        // logical position, 0 is the top and getSize() is the end
+        std::size_t position;
+
+    };
+
+    Iterator<false> begin();
+    Iterator<false> end();
+
+    Iterator<true> begin() const;
+    Iterator<true> end() const;
+
+    Iterator<true> cbegin() const;
+    Iterator<true> cend() const;
+
+};
+
+} // namespace RB
+
+#include "StaticRingBuffer.inl"
+
+#endif
@@ -0,0 +1,427 @@
+
+#include <stdexcept>
+#include <new>
+#include <utility>
+
+#include "Error.hpp"
+
+template <typename T, std::size_t N>
+RB::StaticRingBuffer<T, N>::StaticRingBuffer() :
+r(0),
+size(0),
+overwritePolicy_overwriteOldest(false)
+{
+}
+
+template <typename T, std::size_t N>
+RB::StaticRingBuffer<T, N>::~StaticRingBuffer()
+{
+    clear();
+}
+
+template <typename T, std::size_t N>
+RB::StaticRingBuffer<T, N>::StaticRingBuffer(const RB::StaticRingBuffer<T, N>& other) :
+r(0),
+size(0),
+overwritePolicy_overwriteOldest(other.overwritePolicy_overwriteOldest)
+{
+    for(std::size_t i = 0; i < other.size; ++i)
+    {
+        push(other[i]);
+    }
+}
+
+template <typename T, std::size_t N>
+RB::StaticRingBuffer<T, N>& RB::StaticRingBuffer<T, N>::operator =(const RB::StaticRingBuffer<T, N>& other)
+{
+    if(this != &other)
+    {
+        clear();
+        overwritePolicy_overwriteOldest = other.overwritePolicy_overwriteOldest;
+        for(std::size_t i = 0; i < other.size; ++i)
+        {
+            push(other[i]);
+        }
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N>
+RB::StaticRingBuffer<T, N>::StaticRingBuffer(RB::StaticRingBuffer<T, N>&& other) noexcept(std::is_nothrow_move_constructible<T>::value) :
+r(0),
+size(0),
+overwritePolicy_overwriteOldest(other.overwritePolicy_overwriteOldest)
+{
+    // storage is inline, so elements have to be moved one by one
+    for(std::size_t i = 0; i < other.size; ++i)
+    {
+        push(std::move(other[i]));
+    }
+    other.clear();
+}
+
+template <typename T, std::size_t N>
+RB::StaticRingBuffer<T, N>& RB::StaticRingBuffer<T, N>::operator =(RB::StaticRingBuffer<T, N>&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+{
+    if(this != &other)
+    {
+        clear();
+        overwritePolicy_overwriteOldest = other.overwritePolicy_overwriteOldest;
+        for(std::size_t i = 0; i < other.size; ++i)
+        {
+            push(std::move(other[i]));
+        }
+        other.clear();
+    }
+    return *this;
+}
+
+template <typename T, std::size_t N>
+bool RB::StaticRingBuffer<T, N>::push(const T& reference)
+{
+    if(size == N && overwritePolicy_overwriteOldest)
+    {
+        // the oldest element is in the slot being written, assign over it
+        *slot(size) = reference;
+        r = (r + 1) % N;
+        return true;
+    }
+    checkPush();
+
+    new (slot(size)) T(reference);
+    ++size;
+    return false;
+}
+
+template <typename T, std::size_t N>
+bool RB::StaticRingBuffer<T, N>::push(T&& r_value)
+{
+    if(size == N && overwritePolicy_overwriteOldest)
+    {
+        // the oldest element is in the slot being written, assign over it
+        *slot(size) = std::forward<T>(r_value);
+        r = (r + 1) % N;
+        return true;
+    }
+    checkPush();
+
+    new (slot(size)) T(std::forward<T>(r_value));
+    ++size;
+    return false;
+}
+
+template <typename T, std::size_t N>
+void RB::StaticRingBuffer<T, N>::pop()
+{
+    checkPop();
+
+    slot(0)->~T();
+    r = (r + 1) % N;
+    --size;
+}
+
+template <typename T, std::size_t N>
+T& RB::StaticRingBuffer<T, N>::top()
+{
+    return *slot(0);
+}
+
+template <typename T, std::size_t N>
+const T& RB::StaticRingBuffer<T, N>::top() const
+{
+    return *slot(0);
+}
+
+template <typename T, std::size_t N>
+T& RB::StaticRingBuffer<T, N>::operator [](std::size_t index)
+{
+    return *slot(index);
+}
+
+template <typename T, std::size_t N>
+const T& RB::StaticRingBuffer<T, N>::operator [](std::size_t index) const
+{
+    return *slot(index);
+}
+
+template <typename T, std::size_t N>
+T& RB::StaticRingBuffer<T, N>::at(std::size_t index)
+{
+    if(index >= size)
+    {
+        RING_BUFFER_THROW(std::out_of_range("ERROR: Index is too large!"));
+    }
+
+    return *slot(index);
+}
+
+template <typename T, std::size_t N>
+const T& RB::StaticRingBuffer<T, N>::at(std::size_t index) const
+{
+    if(index >= size)
+    {
+        RING_BUFFER_THROW(std::out_of_range("ERROR: Index is too large!"));
+    }
+
+    return *slot(index);
+}
+
+template <typename T, std::size_t N>
+bool RB::StaticRingBuffer<T, N>::empty() const
+{
+    return size == 0;
+}
+
+template <typename T, std::size_t N>
+constexpr std::size_t RB::StaticRingBuffer<T, N>::getCapacity() const
+{
+    return N;
+}
+
+template <typename T, std::size_t N>
+std::size_t RB::StaticRingBuffer<T, N>::getSize() const
+{
+    return size;
+}
+
+template <typename T, std::size_t N>
+void RB::StaticRingBuffer<T, N>::clear()
+{
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        slot(i)->~T();
+    }
+    r = 0;
+    size = 0;
+}
+
+template <typename T, std::size_t N>
+bool RB::StaticRingBuffer<T, N>::setOverwritePolicy(bool overwriteOldest) {
+    bool prev = overwritePolicy_overwriteOldest;
+    overwritePolicy_overwriteOldest = overwriteOldest;
+    return prev;
+}
+
+template <typename T, std::size_t N>
+bool RB::StaticRingBuffer<T, N>::getOverwritePolicy() const {
+    return overwritePolicy_overwriteOldest;
+}
+
+template <typename T, std::size_t N>
+T* RB::StaticRingBuffer<T, N>::slot(std::size_t index)
+{
+    // N is a constant, so this folds to a mask or a multiply
+    return reinterpret_cast<T*>(&storage[(r + index) % N]);
+}
+
+template <typename T, std::size_t N>
+const T* RB::StaticRingBuffer<T, N>::slot(std::size_t index) const
+{
+    return reinterpret_cast<const T*>(&storage[(r + index) % N]);
+}
+
+template <typename T, std::size_t N>
+void RB::StaticRingBuffer<T, N>::checkPush() const
+{
+    if(size == N)
+    {
+        RING_BUFFER_THROW(std::out_of_range("StaticRingBuffer max capacity reached, cannot push!"));
+    }
+}
+
+template <typename T, std::size_t N>
+void RB::StaticRingBuffer<T, N>::checkPop() const
+{
+#ifndef RING_BUFFER_UNCHECKED
+    if(size == 0)
+    {
+        RING_BUFFER_THROW(std::out_of_range("StaticRingBuffer is empty, cannot pop!"));
+    }
+#endif
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+RB::StaticRingBuffer<T, N>::Iterator<IsConst>::Iterator() :
+parent(nullptr),
+position(0)
+{
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+RB::StaticRingBuffer<T, N>::Iterator<IsConst>::Iterator(parent_type* parent, std::size_t position) :
+parent(parent),
+position(position)
+{
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst>::reference RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator *() const
+{
+    return (*parent)[position];
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst>::pointer RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator ->() const
+{
+    return &(*parent)[position];
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst>::reference RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator [](const difference_type& n) const
+{
+    return (*parent)[position + n];
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst>& RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator ++()
+{
+    ++position;
+    return *this;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst> RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator ++(int)
+{
+    Iterator copy = *this;
+    ++position;
+    return copy;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst>& RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator --()
+{
+    --position;
+    return *this;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst> RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator --(int)
+{
+    Iterator copy = *this;
+    --position;
+    return copy;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst>& RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator +=(const difference_type& n)
+{
+    position += n;
+    return *this;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst> RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator +(const difference_type& n) const
+{
+    return Iterator(parent, position + n);
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst>& RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator -=(const difference_type& n)
+{
+    position -= n;
+    return *this;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst> RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator -(const difference_type& n) const
+{
+    return Iterator(parent, position - n);
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+typename RB::StaticRingBuffer<T, N>::template Iterator<IsConst>::difference_type RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator -(const Iterator& other) const
+{
+    return (difference_type)position - (difference_type)other.position;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+bool RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator ==(const Iterator& other) const
+{
+    return position == other.position;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+bool RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator !=(const Iterator& other) const
+{
+    return position != other.position;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+bool RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator <(const Iterator& other) const
+{
+    return position < other.position;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+bool RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator >(const Iterator& other) const
+{
+    return position > other.position;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+bool RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator >=(const Iterator& other) const
+{
+    return position >= other.position;
+}
+
+template <typename T, std::size_t N>
+template <bool IsConst>
+bool RB::StaticRingBuffer<T, N>::Iterator<IsConst>::operator <=(const Iterator& other) const
+{
+    return position <= other.position;
+}
+
+template <typename T, std::size_t N>
+typename RB::StaticRingBuffer<T, N>::template Iterator<false> RB::StaticRingBuffer<T, N>::begin()
+{
+    return Iterator<false>(this, 0);
+}
+
+template <typename T, std::size_t N>
+typename RB::StaticRingBuffer<T, N>::template Iterator<false> RB::StaticRingBuffer<T, N>::end()
+{
+    return Iterator<false>(this, size);
+}
+
+template <typename T, std::size_t N>
+typename RB::StaticRingBuffer<T, N>::template Iterator<true> RB::StaticRingBuffer<T, N>::begin() const
+{
+    return cbegin();
+}
+
+template <typename T, std::size_t N>
+typename RB::StaticRingBuffer<T, N>::template Iterator<true> RB::StaticRingBuffer<T, N>::end() const
+{
+    return cend();
+}
+
+template <typename T, std::size_t N>
+typename RB::StaticRingBuffer<T, N>::template Iterator<true> RB::StaticRingBuffer<T, N>::cbegin() const
+{
+    return Iterator<true>(this, 0);
+}
+
+template <typename T, std::size_t N>
+typename RB::StaticRingBuffer<T, N>::template Iterator<true> RB::StaticRingBuffer<T, N>::cend() const
+{
+    return Iterator<true>(this, size);
+}
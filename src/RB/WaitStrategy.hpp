@@ -0,0 +1,101 @@
+#ifndef WAIT_STRATEGY_HPP
+#define WAIT_STRATEGY_HPP
+
+#include <cstdint>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+namespace RB
+{
+
+/*
+ * How a BlockingQueue thread waits for the queue to change.
+ *
+ * A strategy waits on an epoch, a counter bumped by notify(epoch) whenever
+ * the queue changes in a way a waiter may care about:
+ *
+ * wait(epoch, key) returns once epoch no longer holds key, and
+ * waitUntil(epoch, key, deadline) does the same, but gives up at the deadline
+ * and then returns false. Both may also return early (spuriously), callers
+ * check the queue again either way.
+ *
+ * notify(epoch) bumps the epoch and wakes at least one thread waiting on it.
+ * BlockingQueue only calls it when a thread has announced that it is about to
+ * wait, so an uncontended queue never pays for a wake up.
+ */
+
+typedef std::chrono::steady_clock::time_point WaitDeadline;
+
+/*!
+ * Spins on the epoch without ever giving up the core: the lowest wake up
+ * latency, at the cost of one busy core per waiting thread. Only suited to
+ * threads pinned to cores of their own.
+ */
+class BusySpinWait
+{
+public:
+    void wait(const std::atomic<std::uint32_t>& epoch, std::uint32_t key);
+    bool waitUntil(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, WaitDeadline deadline);
+    void notify(std::atomic<std::uint32_t>& epoch);
+};
+
+/*!
+ * Spins for a short while, then yields the core to other threads between
+ * checks. Wakes up almost as fast as BusySpinWait when the wait is short,
+ * but still keeps the waiting thread runnable.
+ */
+class SpinYieldWait
+{
+public:
+    void wait(const std::atomic<std::uint32_t>& epoch, std::uint32_t key);
+    bool waitUntil(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, WaitDeadline deadline);
+    void notify(std::atomic<std::uint32_t>& epoch);
+
+private:
+    static const unsigned int spinCount = 128;
+};
+
+#ifdef __linux__
+
+/*!
+ * Spins briefly, then parks the thread in the kernel on the epoch itself
+ * with a futex (Linux only). A waiting thread uses no CPU, and notify() costs
+ * a single system call, only made when a thread is waiting.
+ */
+class FutexWait
+{
+public:
+    void wait(const std::atomic<std::uint32_t>& epoch, std::uint32_t key);
+    bool waitUntil(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, WaitDeadline deadline);
+    void notify(std::atomic<std::uint32_t>& epoch);
+
+private:
+    static const unsigned int spinCount = 128;
+};
+
+#endif // __linux__
+
+/*!
+ * Sleeps on a std::condition_variable. Portable, and like FutexWait a
+ * waiting thread uses no CPU, but notify() also takes a mutex.
+ */
+class ConditionVariableWait
+{
+public:
+    void wait(const std::atomic<std::uint32_t>& epoch, std::uint32_t key);
+    bool waitUntil(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, WaitDeadline deadline);
+    void notify(std::atomic<std::uint32_t>& epoch);
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+} // namespace RB
+
+#include "WaitStrategy.inl"
+
+#endif
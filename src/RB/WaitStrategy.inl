@@ -0,0 +1,218 @@
+
+#include <ctime>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+#endif
+
+#ifdef __linux__
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+namespace RB
+{
+namespace detail
+{
+
+/*!
+ * Tells the core that this is a spin loop, so it backs off (and leaves the
+ * pipeline to the other hyperthread) instead of speculating ahead.
+ */
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/*!
+ * Spins with cpuRelax() until epoch no longer holds key or the deadline
+ * passes, reading the clock only every few iterations.
+ */
+inline bool spinUntil(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, RB::WaitDeadline deadline)
+{
+    for(unsigned int i = 1; epoch.load(std::memory_order_acquire) == key; ++i)
+    {
+        if(i % 64 == 0 && std::chrono::steady_clock::now() >= deadline)
+        {
+            return epoch.load(std::memory_order_acquire) != key;
+        }
+        cpuRelax();
+    }
+    return true;
+}
+
+/*!
+ * Spins at most count times. Returns true if epoch no longer holds key.
+ */
+inline bool spinFor(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, unsigned int count)
+{
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        if(epoch.load(std::memory_order_acquire) != key)
+        {
+            return true;
+        }
+        cpuRelax();
+    }
+    return epoch.load(std::memory_order_acquire) != key;
+}
+
+} // namespace detail
+} // namespace RB
+
+inline void RB::BusySpinWait::wait(const std::atomic<std::uint32_t>& epoch, std::uint32_t key)
+{
+    while(epoch.load(std::memory_order_acquire) == key)
+    {
+        detail::cpuRelax();
+    }
+}
+
+inline bool RB::BusySpinWait::waitUntil(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, RB::WaitDeadline deadline)
+{
+    return detail::spinUntil(epoch, key, deadline);
+}
+
+inline void RB::BusySpinWait::notify(std::atomic<std::uint32_t>& epoch)
+{
+    epoch.fetch_add(1, std::memory_order_release);
+}
+
+inline void RB::SpinYieldWait::wait(const std::atomic<std::uint32_t>& epoch, std::uint32_t key)
+{
+    if(detail::spinFor(epoch, key, spinCount))
+    {
+        return;
+    }
+    while(epoch.load(std::memory_order_acquire) == key)
+    {
+        std::this_thread::yield();
+    }
+}
+
+inline bool RB::SpinYieldWait::waitUntil(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, RB::WaitDeadline deadline)
+{
+    if(detail::spinFor(epoch, key, spinCount))
+    {
+        return true;
+    }
+    while(epoch.load(std::memory_order_acquire) == key)
+    {
+        if(std::chrono::steady_clock::now() >= deadline)
+        {
+            return epoch.load(std::memory_order_acquire) != key;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+inline void RB::SpinYieldWait::notify(std::atomic<std::uint32_t>& epoch)
+{
+    epoch.fetch_add(1, std::memory_order_release);
+}
+
+#ifdef __linux__
+
+namespace RB
+{
+namespace detail
+{
+
+/*!
+ * Sleeps while epoch holds key, for at most timeout if it is not null.
+ * The kernel checks the value and queues the thread atomically, so a notify
+ * between reading the epoch and calling this is never lost.
+ */
+inline void futexWait(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, const timespec* timeout)
+{
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+        "the futex word must be a plain 32 bit integer");
+    syscall(SYS_futex, reinterpret_cast<const std::uint32_t*>(&epoch), FUTEX_WAIT_PRIVATE, key, timeout, nullptr, 0);
+}
+
+} // namespace detail
+} // namespace RB
+
+inline void RB::FutexWait::wait(const std::atomic<std::uint32_t>& epoch, std::uint32_t key)
+{
+    if(detail::spinFor(epoch, key, spinCount))
+    {
+        return;
+    }
+    while(epoch.load(std::memory_order_acquire) == key)
+    {
+        detail::futexWait(epoch, key, nullptr);
+    }
+}
+
+inline bool RB::FutexWait::waitUntil(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, RB::WaitDeadline deadline)
+{
+    if(detail::spinFor(epoch, key, spinCount))
+    {
+        return true;
+    }
+    while(epoch.load(std::memory_order_acquire) == key)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if(now >= deadline)
+        {
+            return false;
+        }
+
+        // FUTEX_WAIT takes a relative timeout
+        const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+        timespec timeout;
+        timeout.tv_sec = remaining / 1000000000;
+        timeout.tv_nsec = remaining % 1000000000;
+        detail::futexWait(epoch, key, &timeout);
+    }
+    return true;
+}
+
+inline void RB::FutexWait::notify(std::atomic<std::uint32_t>& epoch)
+{
+    epoch.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&epoch), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+#endif // __linux__
+
+inline void RB::ConditionVariableWait::wait(const std::atomic<std::uint32_t>& epoch, std::uint32_t key)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while(epoch.load(std::memory_order_acquire) == key)
+    {
+        condition.wait(lock);
+    }
+}
+
+inline bool RB::ConditionVariableWait::waitUntil(const std::atomic<std::uint32_t>& epoch, std::uint32_t key, RB::WaitDeadline deadline)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while(epoch.load(std::memory_order_acquire) == key)
+    {
+        if(condition.wait_until(lock, deadline) == std::cv_status::timeout)
+        {
+            return epoch.load(std::memory_order_acquire) != key;
+        }
+    }
+    return true;
+}
+
+inline void RB::ConditionVariableWait::notify(std::atomic<std::uint32_t>& epoch)
+{
+    {
+        // bumped under the mutex, so it cannot land between a waiter's check
+        // and its wait
+        std::lock_guard<std::mutex> lock(mutex);
+        epoch.fetch_add(1, std::memory_order_release);
+    }
+    condition.notify_one();
+}
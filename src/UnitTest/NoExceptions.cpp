@@ -0,0 +1,75 @@
+// Built with -fno-exceptions: every header must compile, and errors must go to
+// RING_BUFFER_ERROR_HANDLER, which has to end the program.
+
+#include <cstdio>
+#include <cstdlib>
+
+#define RING_BUFFER_ERROR_HANDLER(exception) \
+    (std::printf("handled: %s\n", (exception).what()), std::fflush(stdout), std::exit(0))
+
+#include <RB/RingBuffer.hpp>
+#include <RB/SPSCRingBuffer.hpp>
+#include <RB/MPMCQueue.hpp>
+#include <RB/StaticRingBuffer.hpp>
+#include <RB/MirroredRingBuffer.hpp>
+#include <RB/BlockingQueue.hpp>
+#include <RB/SlidingWindow.hpp>
+#include <RB/Reduce.hpp>
+#include <RB/ByteRingBuffer.hpp>
+
+int main()
+{
+    RB::RingBuffer<int> rb(2);
+    int out = 0;
+    if(!rb.try_push(1) || !rb.try_emplace(2) || rb.try_push(3)
+        || !rb.try_pop(out) || out != 1)
+    {
+        return 1;
+    }
+    rb.changeCapacity(4);
+    rb.changeSize(3, 7);
+    if(rb.at(2) != 7)
+    {
+        return 1;
+    }
+
+    RB::SPSCRingBuffer<int> spsc(2);
+    RB::MPMCQueue<int> mpmc(2);
+    RB::StaticRingBuffer<int, 2> fixed;
+    if(!spsc.try_push(1) || !spsc.try_pop(out) || !mpmc.try_push(1) || !mpmc.try_pop(out))
+    {
+        return 1;
+    }
+    fixed.push(1);
+    fixed.pop();
+
+    RB::BlockingQueue<int, RB::SpinYieldWait> blocking(1);
+    blocking.push_wait(1);
+    if(blocking.push_wait_for(2, std::chrono::milliseconds(1)) || !blocking.pop_wait_for(out, std::chrono::milliseconds(1)))
+    {
+        return 1;
+    }
+#ifdef __linux__
+    RB::MirroredRingBuffer<int> mirrored(1);
+    mirrored.push(1);
+    mirrored.pop();
+#endif
+
+    if(RB::sum(rb) != 16)
+    {
+        return 1;
+    }
+
+    RB::ByteRingBuffer bytes(4);
+    char chunk[4] = {};
+    if(bytes.write("abcdef", 6) != 4 || bytes.read(chunk, 4) != 4)
+    {
+        return 1;
+    }
+
+    rb.clear();
+    rb.pop();
+
+    std::printf("the error handler was not called\n");
+    return 1;
+}
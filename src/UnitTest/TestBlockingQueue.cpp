@@ -0,0 +1,214 @@
+#include <cstdint>
+
+#include <thread>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+
+#include "gtest/gtest.h"
+
+#include <RB/BlockingQueue.hpp>
+
+using namespace RB;
+
+namespace
+{
+
+template <typename WaitStrategy>
+void checkPopPush()
+{
+    BlockingQueue<int, WaitStrategy> queue(3);
+    EXPECT_EQ(3, queue.getCapacity());
+    EXPECT_TRUE(queue.empty());
+
+    int value = -1;
+    for(int j = 0; j < 3; ++j)
+    {
+        queue.push_wait(0);
+        EXPECT_TRUE(queue.try_push(1));
+        EXPECT_TRUE(queue.try_emplace(2));
+        EXPECT_EQ(3, queue.getSize());
+        EXPECT_FALSE(queue.try_push(3));
+        EXPECT_FALSE(queue.push_wait_for(3, std::chrono::milliseconds(1)));
+
+        for(int i = 0; i < 3; ++i)
+        {
+            queue.pop_wait(value);
+            EXPECT_EQ(i, value);
+        }
+        EXPECT_TRUE(queue.empty());
+
+        value = -1;
+        EXPECT_FALSE(queue.try_pop(value));
+        EXPECT_FALSE(queue.pop_wait_for(value, std::chrono::milliseconds(1)));
+        EXPECT_EQ(-1, value);
+
+        // offset the indices for the next round
+        EXPECT_TRUE(queue.push_wait_for(7, std::chrono::milliseconds(1)));
+        EXPECT_TRUE(queue.pop_wait_for(value, std::chrono::milliseconds(1)));
+        EXPECT_EQ(7, value);
+    }
+}
+
+template <typename WaitStrategy>
+void checkWakesUp()
+{
+    BlockingQueue<int, WaitStrategy> queue(1);
+
+    // the consumer is asleep on an empty queue long before the push
+    int value = -1;
+    std::thread consumer([&queue, &value] () {
+        queue.pop_wait(value);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.push_wait(42);
+    consumer.join();
+    EXPECT_EQ(42, value);
+
+    // and the producer on a full one
+    queue.push_wait(1);
+    std::thread producer([&queue] () {
+        queue.push_wait(2);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.pop_wait(value);
+    EXPECT_EQ(1, value);
+    producer.join();
+    queue.pop_wait(value);
+    EXPECT_EQ(2, value);
+
+    // a timed wait is woken before its timeout
+    std::thread late([&queue] () {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.push_wait(3);
+    });
+    EXPECT_TRUE(queue.pop_wait_for(value, std::chrono::seconds(10)));
+    EXPECT_EQ(3, value);
+    late.join();
+}
+
+/*
+ * Every producer pushes its id with an increasing count, a small capacity
+ * keeps both sides blocking, and every value must come out exactly once and
+ * in order per producer.
+ */
+template <typename WaitStrategy>
+void checkStress(unsigned int countPerProducer)
+{
+    const unsigned int producers = 3;
+    const unsigned int consumers = 3;
+    BlockingQueue<std::uint64_t, WaitStrategy> queue(4);
+
+    std::vector<std::thread> threads;
+    for(unsigned int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&queue, p, countPerProducer] () {
+            for(std::uint64_t i = 0; i < countPerProducer; ++i)
+            {
+                queue.push_wait((std::uint64_t)p << 32 | i);
+            }
+        });
+    }
+
+    std::vector<std::vector<std::uint64_t>> received(consumers);
+    std::atomic<unsigned int> remaining(producers * countPerProducer);
+    for(unsigned int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&queue, &received, &remaining, c] () {
+            std::uint64_t value = 0;
+            while(remaining.load() != 0)
+            {
+                if(queue.pop_wait_for(value, std::chrono::milliseconds(1)))
+                {
+                    received[c].push_back(value);
+                    remaining.fetch_sub(1);
+                }
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<unsigned int> counts(producers, 0);
+    bool inOrder = true;
+    for(const std::vector<std::uint64_t>& values : received)
+    {
+        std::vector<std::int64_t> last(producers, -1);
+        for(std::uint64_t value : values)
+        {
+            const unsigned int producer = value >> 32;
+            const std::int64_t i = value & 0xFFFFFFFF;
+            inOrder = inOrder && i > last[producer];
+            last[producer] = i;
+            ++counts[producer];
+        }
+    }
+    EXPECT_TRUE(inOrder);
+    for(unsigned int count : counts)
+    {
+        EXPECT_EQ(countPerProducer, count);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+} // namespace
+
+TEST(BlockingQueue, PopPush)
+{
+    checkPopPush<BusySpinWait>();
+    checkPopPush<SpinYieldWait>();
+#ifdef __linux__
+    checkPopPush<FutexWait>();
+#endif
+    checkPopPush<ConditionVariableWait>();
+}
+
+TEST(BlockingQueue, ZeroCapacity)
+{
+    BlockingQueue<int> queue(0);
+    EXPECT_EQ(0, queue.getCapacity());
+    EXPECT_FALSE(queue.try_push(1));
+    EXPECT_FALSE(queue.push_wait_for(1, std::chrono::milliseconds(1)));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(BlockingQueue, MoveOnly)
+{
+    BlockingQueue<std::unique_ptr<int>> queue(1);
+    queue.push_wait(std::make_unique<int>(1));
+
+    // a push that times out keeps its argument
+    std::unique_ptr<int> kept = std::make_unique<int>(2);
+    EXPECT_FALSE(queue.push_wait_for(std::move(kept), std::chrono::milliseconds(1)));
+    ASSERT_TRUE(kept);
+    EXPECT_EQ(2, *kept);
+
+    std::unique_ptr<int> out;
+    queue.pop_wait(out);
+    EXPECT_EQ(1, *out);
+}
+
+TEST(BlockingQueue, WakesUp)
+{
+    checkWakesUp<BusySpinWait>();
+    checkWakesUp<SpinYieldWait>();
+#ifdef __linux__
+    checkWakesUp<FutexWait>();
+#endif
+    checkWakesUp<ConditionVariableWait>();
+}
+
+TEST(BlockingQueue, Stress)
+{
+    // spinning threads only give up the core when preempted, which is slow
+    // when there are fewer cores than threads
+    checkStress<BusySpinWait>(200);
+    checkStress<SpinYieldWait>(20000);
+#ifdef __linux__
+    checkStress<FutexWait>(20000);
+#endif
+    checkStress<ConditionVariableWait>(20000);
+}
@@ -0,0 +1,312 @@
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <deque>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/socket.h>
+#endif
+
+#include "gtest/gtest.h"
+
+#include <RB/ByteRingBuffer.hpp>
+
+using namespace RB;
+
+TEST(ByteRingBuffer, WriteRead)
+{
+    ByteRingBuffer rb(8);
+    EXPECT_EQ(8, rb.getCapacity());
+    EXPECT_TRUE(rb.empty());
+    EXPECT_EQ(8, rb.getFreeSize());
+
+    EXPECT_EQ(5, rb.write("hello", 5));
+    EXPECT_EQ(5, rb.getSize());
+    EXPECT_EQ('h', rb[0]);
+    EXPECT_EQ('o', rb[4]);
+
+    // only 3 fit
+    EXPECT_EQ(3, rb.write("world", 5));
+    EXPECT_TRUE(rb.full());
+    EXPECT_EQ(0, rb.write("!", 1));
+
+    char out[16] = {};
+    EXPECT_EQ(4, rb.read(out, 4));
+    EXPECT_EQ("hell", std::string(out, 4));
+    EXPECT_EQ(4, rb.getSize());
+
+    // wraps around the end of the storage
+    EXPECT_EQ(4, rb.write("1234", 4));
+    EXPECT_EQ('4', rb[7]);
+
+    // partial read of what is left
+    EXPECT_EQ(8, rb.read(out, sizeof(out)));
+    EXPECT_EQ("owor1234", std::string(out, 8));
+    EXPECT_TRUE(rb.empty());
+    EXPECT_EQ(0, rb.read(out, sizeof(out)));
+}
+
+TEST(ByteRingBuffer, PeekSkip)
+{
+    ByteRingBuffer rb(6);
+    rb.write("abcd", 4);
+    rb.skip(3);
+    rb.write("efghi", 5);
+
+    // "defghi", starting at index 3 of the storage
+    char out[8] = {};
+    EXPECT_EQ(6, rb.peek(out, sizeof(out)));
+    EXPECT_EQ("defghi", std::string(out, 6));
+    EXPECT_EQ(3, rb.peek(out, 3, 2));
+    EXPECT_EQ("fgh", std::string(out, 3));
+    EXPECT_EQ(1, rb.peek(out, 3, 5));
+    EXPECT_EQ('i', out[0]);
+    EXPECT_EQ(0, rb.peek(out, 3, 6));
+    EXPECT_EQ(6, rb.getSize());
+
+    EXPECT_EQ(2, rb.skip(2));
+    EXPECT_EQ('f', rb[0]);
+    EXPECT_EQ(4, rb.skip(10));
+    EXPECT_TRUE(rb.empty());
+    EXPECT_EQ(0, rb.skip(1));
+
+    rb.write("xy", 2);
+    rb.clear();
+    EXPECT_TRUE(rb.empty());
+    EXPECT_EQ(6, rb.getFreeSize());
+}
+
+TEST(ByteRingBuffer, ZeroCapacity)
+{
+    ByteRingBuffer rb(0);
+    char out[4] = {};
+    EXPECT_TRUE(rb.empty());
+    EXPECT_TRUE(rb.full());
+    EXPECT_EQ(0, rb.write("abcd", 4));
+    EXPECT_EQ(0, rb.read(out, 4));
+    EXPECT_EQ(0, rb.peek(out, 4));
+    EXPECT_EQ(0, rb.skip(4));
+}
+
+TEST(ByteRingBuffer, CopyMove)
+{
+    ByteRingBuffer rb(4);
+    rb.write("ab", 2);
+    rb.skip(1);
+    rb.write("cde", 3);
+
+    ByteRingBuffer copy(rb);
+    EXPECT_EQ(4, copy.getCapacity());
+    EXPECT_EQ(4, copy.getSize());
+    char out[4] = {};
+    EXPECT_EQ(4, copy.read(out, 4));
+    EXPECT_EQ("bcde", std::string(out, 4));
+    EXPECT_EQ(4, rb.getSize());
+
+    copy = rb;
+    EXPECT_EQ(4, copy.getSize());
+
+    ByteRingBuffer moved(std::move(rb));
+    EXPECT_EQ(0, rb.getCapacity());
+    EXPECT_TRUE(rb.empty());
+    EXPECT_EQ(4, moved.getSize());
+    EXPECT_EQ(4, moved.peek(out, 4));
+    EXPECT_EQ("bcde", std::string(out, 4));
+
+    rb = std::move(moved);
+    EXPECT_EQ(4, rb.getCapacity());
+    EXPECT_EQ('b', rb[0]);
+
+    static_assert(std::is_nothrow_move_constructible<ByteRingBuffer>::value, "");
+    static_assert(std::is_nothrow_move_assignable<ByteRingBuffer>::value, "");
+}
+
+TEST(ByteRingBuffer, MatchesDeque)
+{
+    std::mt19937 generator(13);
+    std::uniform_int_distribution<int> actions(0, 3);
+    std::uniform_int_distribution<std::size_t> lengths(0, 40);
+    std::uniform_int_distribution<int> bytes(0, 255);
+
+    ByteRingBuffer rb(37);
+    std::deque<unsigned char> expected;
+    std::vector<unsigned char> chunk(64);
+    bool matches = true;
+    for(int i = 0; i < 5000; ++i)
+    {
+        const std::size_t n = lengths(generator);
+        const int action = actions(generator);
+        if(action == 0)
+        {
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                chunk[j] = static_cast<unsigned char>(bytes(generator));
+            }
+            const std::size_t written = rb.write(chunk.data(), n);
+            matches = matches && written == std::min(n, 37 - expected.size());
+            expected.insert(expected.end(), chunk.begin(), chunk.begin() + written);
+        }
+        else if(action == 1)
+        {
+            const std::size_t moved = rb.read(chunk.data(), n);
+            matches = matches && moved == std::min(n, expected.size())
+                && std::equal(chunk.begin(), chunk.begin() + moved, expected.begin());
+            expected.erase(expected.begin(), expected.begin() + moved);
+        }
+        else if(action == 2)
+        {
+            const std::size_t offset = lengths(generator) / 4;
+            const std::size_t moved = rb.peek(chunk.data(), n, offset);
+            const std::size_t available = offset < expected.size() ? expected.size() - offset : 0;
+            matches = matches && moved == std::min(n, available)
+                && std::equal(chunk.begin(), chunk.begin() + moved, expected.begin() + offset);
+        }
+        else
+        {
+            const std::size_t skipped = rb.skip(n / 4);
+            matches = matches && skipped == std::min(n / 4, expected.size());
+            expected.erase(expected.begin(), expected.begin() + skipped);
+        }
+        matches = matches && rb.getSize() == expected.size();
+    }
+    EXPECT_TRUE(matches);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+namespace
+{
+
+void setNonBlocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+} // namespace
+
+TEST(ByteRingBuffer, Pipe)
+{
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+
+    // "cdefgh" wrapping after "cdef"
+    ByteRingBuffer out(6);
+    out.write("abcd", 4);
+    out.skip(2);
+    out.write("efgh", 4);
+    EXPECT_EQ(6, out.writeTo(fds[1]));
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(0, out.writeTo(fds[1]));
+
+    char received[8] = {};
+    EXPECT_EQ(6, ::read(fds[0], received, sizeof(received)));
+    EXPECT_EQ("cdefgh", std::string(received, 6));
+
+    // reads into the free space on both sides of the wrap point
+    ByteRingBuffer in(8);
+    in.write("xyz12", 5);
+    in.skip(4);
+    EXPECT_EQ(6, ::write(fds[1], "345678", 6));
+    EXPECT_EQ(6, in.readFrom(fds[0]));
+    EXPECT_EQ(7, in.getSize());
+    EXPECT_EQ(7, in.read(received, sizeof(received)));
+    EXPECT_EQ("2345678", std::string(received, 7));
+
+    // an empty non blocking pipe, then a full buffer
+    setNonBlocking(fds[0]);
+    errno = 0;
+    EXPECT_EQ(-1, in.readFrom(fds[0]));
+    EXPECT_EQ(EAGAIN, errno);
+    EXPECT_EQ(10, ::write(fds[1], "0123456789", 10));
+    EXPECT_EQ(8, in.readFrom(fds[0]));
+    EXPECT_TRUE(in.full());
+    errno = 0;
+    EXPECT_EQ(-1, in.readFrom(fds[0]));
+    EXPECT_EQ(ENOBUFS, errno);
+
+    // the last 2 bytes, then end of file
+    in.clear();
+    close(fds[1]);
+    EXPECT_EQ(2, in.readFrom(fds[0]));
+    EXPECT_EQ('8', in[0]);
+    EXPECT_EQ(0, in.readFrom(fds[0]));
+    close(fds[0]);
+}
+
+TEST(ByteRingBuffer, SocketPair)
+{
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    setNonBlocking(fds[0]);
+    setNonBlocking(fds[1]);
+
+    // stream through two small rings of odd sizes, so both wrap at every
+    // offset and the reads and writes come in mismatched chunks
+    const std::size_t total = 1 << 20;
+    std::mt19937 generator(17);
+    std::uniform_int_distribution<std::size_t> lengths(1, 3000);
+    ByteRingBuffer sending(4093);
+    ByteRingBuffer receiving(3001);
+    std::vector<unsigned char> chunk(3000);
+    std::size_t produced = 0;
+    std::size_t consumed = 0;
+    bool matches = true;
+    while(consumed < total && matches)
+    {
+        // queue the next bytes of the sequence
+        std::size_t n = std::min(std::min(lengths(generator), sending.getFreeSize()), total - produced);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            chunk[i] = static_cast<unsigned char>((produced + i) % 251);
+        }
+        produced += sending.write(chunk.data(), n);
+
+        const std::size_t queued = sending.getSize();
+        const ssize_t sent = sending.writeTo(fds[0]);
+        matches = matches && (sent >= 0 ? sending.getSize() == queued - sent : errno == EAGAIN);
+
+        const ssize_t received = receiving.readFrom(fds[1]);
+        matches = matches && (received > 0 || errno == EAGAIN || errno == ENOBUFS);
+
+        n = receiving.read(chunk.data(), lengths(generator));
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            matches = matches && chunk[i] == (consumed + i) % 251;
+        }
+        consumed += n;
+    }
+    EXPECT_TRUE(matches);
+    EXPECT_EQ(total, consumed);
+
+    // more than the socket buffer holds, so the first write is partial and
+    // the rest stays queued
+    ByteRingBuffer large(4 << 20);
+    std::vector<unsigned char> filler(large.getCapacity(), 7);
+    large.write(filler.data(), filler.size());
+    const ssize_t sent = large.writeTo(fds[0]);
+    EXPECT_GT(sent, 0);
+    EXPECT_LT(static_cast<std::size_t>(sent), filler.size());
+    EXPECT_EQ(filler.size() - sent, large.getSize());
+    errno = 0;
+    EXPECT_EQ(-1, large.writeTo(fds[0]));
+    EXPECT_EQ(EAGAIN, errno);
+
+    close(fds[0]);
+    std::size_t drained = 0;
+    ssize_t received = 0;
+    while((received = receiving.readFrom(fds[1])) > 0)
+    {
+        drained += receiving.skip(received);
+    }
+    EXPECT_EQ(0, received);
+    EXPECT_EQ(static_cast<std::size_t>(sent), drained);
+    close(fds[1]);
+}
+
+#endif
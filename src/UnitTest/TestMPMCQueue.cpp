@@ -0,0 +1,214 @@
+#include <thread>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include <RB/MPMCQueue.hpp>
+
+using namespace RB;
+
+TEST(MPMCQueue, PopPush)
+{
+    MPMCQueue<int> queue(5);
+    EXPECT_EQ(5, queue.getCapacity());
+    EXPECT_TRUE(queue.empty());
+
+    int value = -1;
+    for(int j = 0; j < 3; ++j)
+    {
+        for(int i = 0; i < 5; ++i)
+        {
+            EXPECT_TRUE(queue.try_push(i));
+            EXPECT_EQ(i + 1, queue.getSize());
+        }
+        EXPECT_FALSE(queue.try_push(5));
+
+        for(int i = 0; i < 5; ++i)
+        {
+            EXPECT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(i, value);
+        }
+        EXPECT_TRUE(queue.empty());
+
+        value = -1;
+        EXPECT_FALSE(queue.try_pop(value));
+        EXPECT_EQ(-1, value);
+
+        // offset the positions for the next round
+        EXPECT_TRUE(queue.try_emplace(7));
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(7, value);
+    }
+}
+
+TEST(MPMCQueue, ZeroCapacity)
+{
+    MPMCQueue<int> queue(0);
+    EXPECT_EQ(0, queue.getCapacity());
+    EXPECT_FALSE(queue.try_push(1));
+
+    int value = -1;
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MPMCQueue, DestroysRemaining)
+{
+    auto shared = std::make_shared<int>(1);
+    {
+        MPMCQueue<std::shared_ptr<int>> queue(4);
+        queue.try_push(shared);
+        queue.try_push(shared);
+        queue.try_push(shared);
+
+        std::shared_ptr<int> out;
+        EXPECT_TRUE(queue.try_pop(out));
+        out.reset();
+        EXPECT_EQ(3, shared.use_count());
+    }
+    EXPECT_EQ(1, shared.use_count());
+}
+
+namespace
+{
+
+/*!
+ * Copying throws when the value is negative, moving never does.
+ */
+struct ThrowingCopy
+{
+    int value;
+
+    explicit ThrowingCopy(int value = 0) :
+    value(value)
+    {
+    }
+
+    ThrowingCopy(const ThrowingCopy& other) :
+    value(other.value)
+    {
+        if(value < 0)
+        {
+            throw std::runtime_error("copy");
+        }
+    }
+
+    ThrowingCopy(ThrowingCopy&& other) noexcept = default;
+    ThrowingCopy& operator=(const ThrowingCopy& other) = default;
+    ThrowingCopy& operator=(ThrowingCopy&& other) noexcept = default;
+};
+
+} // namespace
+
+TEST(MPMCQueue, ThrowingCopyLeavesQueueUsable)
+{
+    MPMCQueue<ThrowingCopy> queue(2);
+    const ThrowingCopy bad(-1);
+    const ThrowingCopy good(5);
+
+    bool exceptionThrown = false;
+    try
+    {
+        queue.try_push(bad);
+    }
+    catch (const std::runtime_error& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+    EXPECT_TRUE(queue.empty());
+
+    // the position was not claimed, so the queue still works
+    EXPECT_TRUE(queue.try_push(good));
+    EXPECT_TRUE(queue.try_emplace(6));
+    EXPECT_FALSE(queue.try_push(good));
+    ThrowingCopy out;
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(5, out.value);
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(6, out.value);
+    EXPECT_FALSE(queue.try_pop(out));
+}
+
+TEST(MPMCQueue, StressFIFOPerProducer)
+{
+    const unsigned int producers = 4;
+    const unsigned int consumers = 4;
+    const unsigned int perProducer = 200000;
+
+    // high bits are the producer, low bits are that producer's counter
+    MPMCQueue<unsigned long long> queue(64);
+
+    std::vector<std::thread> threads;
+    for(unsigned int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&queue, p, perProducer] () {
+            for(unsigned long long i = 0; i < perProducer; ++i)
+            {
+                while(!queue.try_push(((unsigned long long)p << 32) | i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::atomic<unsigned int> remaining(producers * perProducer);
+    std::vector<std::vector<unsigned long long>> received(consumers);
+    std::vector<char> inOrder(consumers, true);
+    for(unsigned int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&, c] () {
+            // what this consumer expects next from each producer at minimum
+            std::vector<unsigned long long> nextMinimum(producers, 0);
+            std::vector<unsigned long long>& counts = received[c];
+            counts.assign(producers, 0);
+
+            unsigned long long value;
+            while(remaining.load() != 0)
+            {
+                if(!queue.try_pop(value))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                --remaining;
+
+                const unsigned int p = value >> 32;
+                const unsigned long long i = value & 0xFFFFFFFF;
+                if(p >= producers || i < nextMinimum[p])
+                {
+                    inOrder[c] = false;
+                }
+                else
+                {
+                    nextMinimum[p] = i + 1;
+                    ++counts[p];
+                }
+            }
+        });
+    }
+
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for(unsigned int c = 0; c < consumers; ++c)
+    {
+        EXPECT_TRUE(inOrder[c]);
+    }
+    for(unsigned int p = 0; p < producers; ++p)
+    {
+        unsigned long long total = 0;
+        for(unsigned int c = 0; c < consumers; ++c)
+        {
+            total += received[c][p];
+        }
+        EXPECT_EQ(perProducer, total);
+    }
+    EXPECT_TRUE(queue.empty());
+}
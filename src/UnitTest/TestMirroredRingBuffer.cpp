@@ -0,0 +1,154 @@
+#ifdef __linux__
+
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include <RB/MirroredRingBuffer.hpp>
+
+using namespace RB;
+
+TEST(MirroredRingBuffer, Capacity)
+{
+    const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+
+    MirroredRingBuffer<std::uint32_t> rb(10);
+    EXPECT_EQ(pageSize / sizeof(std::uint32_t), rb.getCapacity());
+
+    MirroredRingBuffer<char> zero(0);
+    EXPECT_EQ(pageSize, zero.getCapacity());
+
+    // sizes that don't divide the page size get enough pages to fit exactly
+    struct Odd { char bytes[3]; };
+    MirroredRingBuffer<Odd> odd(1);
+    EXPECT_EQ(0, odd.getCapacity() * sizeof(Odd) % pageSize);
+}
+
+TEST(MirroredRingBuffer, PopPush)
+{
+    MirroredRingBuffer<int> rb(1);
+    const std::size_t capacity = rb.getCapacity();
+
+    for(int j = 0; j < 3; ++j)
+    {
+        for(std::size_t i = 0; i < capacity; ++i)
+        {
+            EXPECT_FALSE(rb.push((int)i));
+        }
+        EXPECT_EQ(capacity, rb.getSize());
+
+        bool exceptionThrown = false;
+        try
+        {
+            rb.push(0);
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+
+        for(std::size_t i = 0; i < capacity; ++i)
+        {
+            EXPECT_EQ((int)i, rb.top());
+            rb.pop();
+        }
+        EXPECT_TRUE(rb.empty());
+
+        exceptionThrown = false;
+        try
+        {
+            rb.pop();
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+
+        // offset the read index for the next round
+        rb.push(0);
+        rb.push(0);
+        rb.push(0);
+        rb.discard(3);
+    }
+}
+
+TEST(MirroredRingBuffer, ContiguousAcrossWrap)
+{
+    MirroredRingBuffer<int> rb(1);
+    const std::size_t capacity = rb.getCapacity();
+
+    // move the read index close to the end of the storage
+    for(std::size_t i = 0; i < capacity - 3; ++i)
+    {
+        rb.push(-1);
+    }
+    rb.discard(capacity - 3);
+
+    for(std::size_t i = 0; i < capacity; ++i)
+    {
+        rb.push((int)i);
+    }
+
+    // the elements wrap in storage, but are contiguous through data()
+    const int* contiguous = rb.data();
+    bool inOrder = true;
+    for(std::size_t i = 0; i < capacity; ++i)
+    {
+        inOrder = inOrder && contiguous[i] == (int)i && rb[i] == (int)i;
+    }
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(5, rb.data(5)[0]);
+    EXPECT_EQ(10, rb.data(5)[5]);
+
+    // write through one mapping, read through the other
+    rb.discard(capacity);
+    int values[8] = {10, 11, 12, 13, 14, 15, 16, 17};
+    std::memcpy(rb.writeData(), values, sizeof(values));
+    rb.commit(8);
+    EXPECT_EQ(8, rb.getSize());
+    EXPECT_EQ(0, std::memcmp(rb.data(), values, sizeof(values)));
+    EXPECT_EQ(17, rb.at(7));
+
+    bool exceptionThrown = false;
+    try
+    {
+        rb.commit(capacity);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+}
+
+TEST(MirroredRingBuffer, OverwriteAndMove)
+{
+    MirroredRingBuffer<int> rb(1);
+    const std::size_t capacity = rb.getCapacity();
+    rb.setOverwritePolicy(true);
+
+    for(std::size_t i = 0; i < capacity + 5; ++i)
+    {
+        EXPECT_EQ(i >= capacity, rb.push((int)i));
+    }
+    EXPECT_EQ(5, rb.top());
+    EXPECT_EQ((int)capacity + 4, rb.data()[capacity - 1]);
+
+    MirroredRingBuffer<int> moved(std::move(rb));
+    EXPECT_EQ(0, rb.getCapacity());
+    EXPECT_EQ(capacity, moved.getSize());
+    EXPECT_EQ(5, moved.top());
+
+    static_assert(std::is_nothrow_move_constructible<MirroredRingBuffer<int>>::value, "");
+    static_assert(std::is_nothrow_move_assignable<MirroredRingBuffer<int>>::value, "");
+}
+
+#endif
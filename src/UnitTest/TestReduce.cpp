@@ -0,0 +1,179 @@
+#include <stdexcept>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include <RB/Reduce.hpp>
+
+using namespace RB;
+
+namespace
+{
+
+const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::Vector128, SimdLevel::Vector256};
+
+/*!
+ * A RingBuffer holding n values, starting offset slots into its storage so
+ * that both runs are used.
+ */
+template <typename T, typename Generate>
+RingBuffer<T> makeWrapped(std::size_t n, std::size_t offset, Generate generate)
+{
+    RingBuffer<T> rb(n + 1);
+    for(std::size_t i = 0; i < offset; ++i)
+    {
+        rb.push(T());
+    }
+    rb.discard(offset);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        rb.push(generate());
+    }
+    return rb;
+}
+
+} // namespace
+
+TEST(Reduce, SetSimdLevel)
+{
+    const SimdLevel detected = detectSimdLevel();
+    EXPECT_EQ(detected, getSimdLevel());
+
+    EXPECT_EQ(detected, setSimdLevel(SimdLevel::Scalar));
+    EXPECT_EQ(SimdLevel::Scalar, getSimdLevel());
+
+    // never above what the CPU supports
+    setSimdLevel(SimdLevel::Vector256);
+    EXPECT_EQ(detected, getSimdLevel());
+}
+
+TEST(Reduce, Int32MatchesScalarLoops)
+{
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<std::int32_t> values(std::numeric_limits<std::int32_t>::min(),
+        std::numeric_limits<std::int32_t>::max());
+    // small enough for the dot products to fit in std::int64_t
+    std::uniform_int_distribution<std::int32_t> factors(-(1 << 24), 1 << 24);
+
+    const SimdLevel previous = getSimdLevel();
+    for(SimdLevel level : levels)
+    {
+        setSimdLevel(level);
+        for(std::size_t n : {1, 3, 8, 31, 32, 33, 100, 257, 1000})
+        {
+            RingBuffer<std::int32_t> a = makeWrapped<std::int32_t>(n, n / 3 + 1, [&] () { return values(generator); });
+            RingBuffer<std::int32_t> b = makeWrapped<std::int32_t>(n, n / 2, [&] () { return factors(generator); });
+
+            std::int64_t expectedSum = 0;
+            std::int64_t expectedDot = 0;
+            std::int32_t expectedMin = a[0];
+            std::int32_t expectedMax = a[0];
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                expectedSum += a[i];
+                expectedDot += (std::int64_t)a[i] * b[i];
+                expectedMin = std::min(expectedMin, a[i]);
+                expectedMax = std::max(expectedMax, a[i]);
+            }
+            long double mean = (long double)expectedSum / n;
+            long double expectedVariance = 0;
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                expectedVariance += (a[i] - mean) * (a[i] - mean);
+            }
+            expectedVariance /= n;
+
+            EXPECT_EQ(expectedSum, RB::sum(a)) << "n " << n;
+            EXPECT_EQ(expectedDot, RB::dot(a, b)) << "n " << n;
+            EXPECT_EQ(expectedMin, RB::minimum(a)) << "n " << n;
+            EXPECT_EQ(expectedMax, RB::maximum(a)) << "n " << n;
+            EXPECT_NEAR((double)expectedVariance, RB::variance(a), 1e-9 * (double)expectedVariance) << "n " << n;
+        }
+    }
+    setSimdLevel(previous);
+}
+
+TEST(Reduce, FloatMatchesScalarLoops)
+{
+    std::mt19937 generator(9);
+    std::uniform_real_distribution<float> values(-100.0f, 100.0f);
+
+    const SimdLevel previous = getSimdLevel();
+    for(SimdLevel level : levels)
+    {
+        setSimdLevel(level);
+        for(std::size_t n : {1, 3, 8, 31, 32, 33, 100, 257, 1000})
+        {
+            RingBuffer<float> a = makeWrapped<float>(n, n / 3 + 1, [&] () { return values(generator); });
+            RingBuffer<float> b = makeWrapped<float>(n, n / 2, [&] () { return values(generator); });
+
+            long double expectedSum = 0;
+            long double absoluteSum = 0;
+            long double expectedDot = 0;
+            float expectedMin = a[0];
+            float expectedMax = a[0];
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                expectedSum += a[i];
+                absoluteSum += std::abs(a[i]);
+                expectedDot += (long double)a[i] * b[i];
+                expectedMin = std::min(expectedMin, a[i]);
+                expectedMax = std::max(expectedMax, a[i]);
+            }
+            long double mean = expectedSum / n;
+            long double expectedVariance = 0;
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                expectedVariance += (a[i] - mean) * (a[i] - mean);
+            }
+            expectedVariance /= n;
+
+            // only the order of the additions differs
+            const double tolerance = 1e-5 * (double)absoluteSum;
+            EXPECT_NEAR((double)expectedSum, RB::sum(a), tolerance) << "n " << n;
+            EXPECT_NEAR((double)expectedDot, RB::dot(a, b), 100 * tolerance) << "n " << n;
+            EXPECT_EQ(expectedMin, RB::minimum(a)) << "n " << n;
+            EXPECT_EQ(expectedMax, RB::maximum(a)) << "n " << n;
+            EXPECT_NEAR((double)expectedVariance, RB::variance(a), 1e-4 * (double)expectedVariance) << "n " << n;
+        }
+    }
+    setSimdLevel(previous);
+}
+
+TEST(Reduce, Empty)
+{
+    RingBuffer<float> empty(4);
+    RingBuffer<float> one(4);
+    one.push(2.0f);
+
+    EXPECT_EQ(0.0f, RB::sum(empty));
+    EXPECT_EQ(0.0f, RB::dot(empty, empty));
+    EXPECT_TRUE(std::isnan(RB::variance(empty)));
+    EXPECT_EQ(0.0f, RB::variance(one));
+
+    bool exceptionThrown = false;
+    try
+    {
+        RB::minimum(empty);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+
+    exceptionThrown = false;
+    try
+    {
+        RB::dot(empty, one);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+}
@@ -1,4 +1,15 @@
 #include <stdexcept>
+#include <memory>
+#include <vector>
+#include <list>
+#include <deque>
+#include <random>
+#include <sstream>
+#include <iterator>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
 
 #include "gtest/gtest.h"
 
@@ -1286,6 +1297,168 @@ TEST(RingBuffer, ChangeCapacity)
     EXPECT_EQ(4, rb.getSize());
 }
 
+namespace
+{
+
+// copying throws once copiesLeft reaches 0, moving may throw so it is not used
+struct ThrowingCopy
+{
+    static int copiesLeft;
+    static int alive;
+
+    ThrowingCopy(int value) : value(value) { ++alive; }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value)
+    {
+        if(copiesLeft-- == 0)
+        {
+            throw std::runtime_error("copy");
+        }
+        ++alive;
+    }
+    ThrowingCopy(ThrowingCopy&& other) : value(other.value) { ++alive; }
+    ThrowingCopy& operator =(const ThrowingCopy& other) = default;
+    ~ThrowingCopy() { --alive; }
+
+    int value;
+};
+
+int ThrowingCopy::copiesLeft = 0;
+int ThrowingCopy::alive = 0;
+
+struct CountingCopy
+{
+    static int copies;
+
+    CountingCopy(int value) : value(value) {}
+    CountingCopy(const CountingCopy& other) : value(other.value) { ++copies; }
+    CountingCopy(CountingCopy&& other) noexcept : value(other.value) {}
+    CountingCopy& operator =(const CountingCopy& other) = default;
+    CountingCopy& operator =(CountingCopy&& other) = default;
+
+    int value;
+};
+
+int CountingCopy::copies = 0;
+
+} // namespace
+
+TEST(RingBuffer, OverwriteRangeThrowingCopy)
+{
+    ThrowingCopy::copiesLeft = 100;
+    {
+        std::vector<ThrowingCopy> values;
+        values.reserve(4);
+        for(int i = 0; i < 4; ++i)
+        {
+            values.emplace_back(10 + i);
+        }
+
+        RingBuffer<ThrowingCopy> rb(4);
+        rb.setOverwritePolicy(true);
+        for(int i = 0; i < 4; ++i)
+        {
+            rb.push(ThrowingCopy(i));
+        }
+        EXPECT_EQ(8, ThrowingCopy::alive);
+
+        // every element is evicted, then the first copy throws
+        ThrowingCopy::copiesLeft = 0;
+        EXPECT_THROW(rb.push(values.begin(), values.end()), std::runtime_error);
+        EXPECT_TRUE(rb.empty());
+        EXPECT_EQ(0, rb.getSize());
+        EXPECT_EQ(4, ThrowingCopy::alive);
+
+        // the copies made before the throw stay pushed
+        ThrowingCopy::copiesLeft = 100;
+        rb.push(ThrowingCopy(0));
+        rb.push(ThrowingCopy(1));
+        rb.push(ThrowingCopy(2));
+        ThrowingCopy::copiesLeft = 1;
+        EXPECT_THROW(rb.push(values.begin(), values.begin() + 3), std::runtime_error);
+        EXPECT_EQ(2, rb.getSize());
+        EXPECT_EQ(2, rb.at(0).value);
+        EXPECT_EQ(10, rb.at(1).value);
+        EXPECT_EQ(6, ThrowingCopy::alive);
+        ThrowingCopy::copiesLeft = 100;
+    }
+    EXPECT_EQ(0, ThrowingCopy::alive);
+}
+
+TEST(RingBuffer, ChangeCapacityRelocation)
+{
+    {
+        RingBuffer<ThrowingCopy> rb(6);
+        for(int i = 0; i < 4; ++i)
+        {
+            rb.push(ThrowingCopy(-1));
+            rb.pop();
+        }
+        for(int i = 0; i < 5; ++i)
+        {
+            rb.push(ThrowingCopy(i));
+        }
+        EXPECT_EQ(5, ThrowingCopy::alive);
+
+        // the third copy throws, the RingBuffer is left as it was
+        ThrowingCopy::copiesLeft = 2;
+        EXPECT_THROW(rb.changeCapacity(10), std::runtime_error);
+        EXPECT_EQ(5, ThrowingCopy::alive);
+        EXPECT_EQ(6, rb.getCapacity());
+        EXPECT_EQ(5, rb.getSize());
+        for(int i = 0; i < 5; ++i)
+        {
+            EXPECT_EQ(i, rb.at(i).value);
+        }
+
+        ThrowingCopy::copiesLeft = 100;
+        rb.changeCapacity(10);
+        EXPECT_EQ(5, ThrowingCopy::alive);
+        EXPECT_EQ(10, rb.getCapacity());
+        for(int i = 0; i < 5; ++i)
+        {
+            EXPECT_EQ(i, rb.at(i).value);
+        }
+    }
+    EXPECT_EQ(0, ThrowingCopy::alive);
+
+    // noexcept moves are used, nothing is copied
+    RingBuffer<CountingCopy> moving(4);
+    moving.push(CountingCopy(1));
+    moving.push(CountingCopy(2));
+    moving.pop();
+    moving.push(CountingCopy(3));
+    moving.push(CountingCopy(4));
+    moving.push(CountingCopy(5));
+    CountingCopy::copies = 0;
+    moving.changeCapacity(8);
+    moving.setResizePolicy(false);
+    moving.changeCapacity(2);
+    EXPECT_EQ(0, CountingCopy::copies);
+    EXPECT_EQ(4, moving.top().value);
+    EXPECT_EQ(5, moving.at(1).value);
+
+    // trivially copyable elements are copied in two runs across the wrap
+    RingBuffer<int> trivial(8);
+    for(int i = 0; i < 6; ++i)
+    {
+        trivial.push(-1);
+        trivial.pop();
+    }
+    for(int i = 0; i < 7; ++i)
+    {
+        trivial.push(i);
+    }
+    trivial.changeCapacity(16);
+    for(int i = 0; i < 7; ++i)
+    {
+        EXPECT_EQ(i, trivial[i]);
+    }
+    trivial.setResizePolicy(false);
+    trivial.changeCapacity(3);
+    EXPECT_EQ(4, trivial[0]);
+    EXPECT_EQ(6, trivial[2]);
+}
+
 TEST(RingBuffer, ChangeSize)
 {
     RingBuffer<char> rb(10);
@@ -1359,6 +1532,55 @@ TEST(RingBuffer, ChangeSize)
     EXPECT_EQ(10, rb.getCapacity());
 }
 
+TEST(RingBuffer, ChangeSizeAcrossWrap)
+{
+    RingBuffer<int> rb(8);
+    for(int i = 0; i < 6; ++i)
+    {
+        rb.push(-1);
+        rb.pop();
+    }
+    rb.push(0);
+    rb.push(1);
+
+    // the fill wraps around the end of the storage
+    rb.changeSize(7, 5);
+    EXPECT_EQ(7, rb.getSize());
+    EXPECT_EQ(0, rb[0]);
+    EXPECT_EQ(1, rb[1]);
+    for(std::size_t i = 2; i < 7; ++i)
+    {
+        EXPECT_EQ(5, rb[i]);
+    }
+    rb.changeSize(8, 6);
+    EXPECT_EQ(6, rb[7]);
+
+    // truncating moves w or r back across the wrap
+    rb.changeSize(3);
+    EXPECT_EQ(3, rb.getSize());
+    rb.push(9);
+    EXPECT_EQ(0, rb[0]);
+    EXPECT_EQ(5, rb[2]);
+    EXPECT_EQ(9, rb[3]);
+    rb.setResizePolicy(false);
+    rb.changeSize(2);
+    EXPECT_EQ(5, rb.top());
+    EXPECT_EQ(9, rb[1]);
+    rb.changeSize(0);
+    EXPECT_TRUE(rb.empty());
+
+    bool exceptionThrown = false;
+    try
+    {
+        rb.changeSize(9);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+}
+
 TEST(RingBuffer, resizePolicy) {
     {
         // resize, front is preserved
@@ -1589,3 +1811,1021 @@ TEST(RingBuffer, resizePolicy) {
         EXPECT_TRUE(rb.empty());
     }
 }
+
+TEST(RingBuffer, overwritePolicy)
+{
+    RingBuffer<int> rb(3);
+    EXPECT_FALSE(rb.getOverwritePolicy());
+
+    EXPECT_FALSE(rb.setOverwritePolicy(true));
+    EXPECT_TRUE(rb.getOverwritePolicy());
+
+    EXPECT_FALSE(rb.push(0));
+    EXPECT_FALSE(rb.push(1));
+    EXPECT_FALSE(rb.push(2));
+    EXPECT_EQ(3, rb.getSize());
+
+    // full, pushing evicts the oldest
+    EXPECT_TRUE(rb.push(3));
+    EXPECT_EQ(3, rb.getSize());
+    EXPECT_EQ(1, rb.top());
+
+    for(int i = 4; i < 11; ++i)
+    {
+        const int value = i;
+        EXPECT_TRUE(rb.push(value));
+        EXPECT_EQ(3, rb.getSize());
+        EXPECT_EQ(i - 2, rb.top());
+        for(unsigned int j = 0; j < 3; ++j)
+        {
+            EXPECT_EQ(i - 2 + (int)j, rb.at(j));
+        }
+    }
+
+    {
+        // copies keep the policy and a full buffer's contents
+        RingBuffer<int> copy(rb);
+        EXPECT_TRUE(copy.getOverwritePolicy());
+        EXPECT_EQ(3, copy.getSize());
+        for(unsigned int j = 0; j < 3; ++j)
+        {
+            EXPECT_EQ(8 + (int)j, copy.at(j));
+        }
+        EXPECT_TRUE(copy.push(11));
+        EXPECT_EQ(9, copy.top());
+    }
+
+    rb.pop();
+    EXPECT_FALSE(rb.push(11));
+    EXPECT_EQ(9, rb.top());
+
+    rb.setOverwritePolicy(false);
+    bool exceptionThrown = false;
+    try
+    {
+        rb.push(12);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+
+    {
+        // nothing to overwrite without capacity
+        RingBuffer<int> empty(0);
+        empty.setOverwritePolicy(true);
+        exceptionThrown = false;
+        try
+        {
+            empty.push(0);
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+    }
+}
+
+namespace
+{
+
+struct NoDefault
+{
+    NoDefault(int value) : value(value) {}
+    int value;
+};
+
+struct Message
+{
+    static int copies;
+    static int moves;
+
+    Message(int id, std::string text) : id(id), text(std::move(text)) {}
+    Message(const Message& other) : id(other.id), text(other.text) { ++copies; }
+    Message(Message&& other) noexcept : id(other.id), text(std::move(other.text)) { ++moves; }
+    Message& operator =(const Message& other)
+    {
+        id = other.id;
+        text = other.text;
+        ++copies;
+        return *this;
+    }
+    Message& operator =(Message&& other) noexcept
+    {
+        id = other.id;
+        text = std::move(other.text);
+        ++moves;
+        return *this;
+    }
+
+    int id;
+    std::string text;
+};
+
+int Message::copies = 0;
+int Message::moves = 0;
+
+} // namespace
+
+TEST(RingBuffer, Emplace)
+{
+    RingBuffer<Message> rb(3);
+    rb.push(Message(0, "zero"));
+    rb.pop();
+
+    // constructed in place, nothing copied or moved
+    Message::copies = 0;
+    Message::moves = 0;
+    Message& first = rb.emplace(1, "one");
+    Message& second = rb.emplace(2, "two");
+    EXPECT_EQ(0, Message::copies);
+    EXPECT_EQ(0, Message::moves);
+    EXPECT_EQ(1, first.id);
+    EXPECT_EQ(&rb.top(), &first);
+    EXPECT_EQ(&rb[1], &second);
+
+    // push copies straight into the slot
+    const Message third(3, "three");
+    rb.push(third);
+    EXPECT_EQ(1, Message::copies);
+    EXPECT_EQ(0, Message::moves);
+    EXPECT_EQ("three", rb[2].text);
+
+    // overwriting with an argument that refers to the overwritten element
+    rb.setOverwritePolicy(true);
+    Message& wrapped = rb.emplace(rb.top());
+    EXPECT_EQ(3, rb.getSize());
+    EXPECT_EQ(&rb[2], &wrapped);
+    EXPECT_EQ(1, wrapped.id);
+    EXPECT_EQ("one", wrapped.text);
+    EXPECT_EQ(2, rb.top().id);
+
+    // and growing with one that refers to a relocated element
+    rb.setGrowthPolicy();
+    Message& grown = rb.emplace(rb.top());
+    EXPECT_EQ(6, rb.getCapacity());
+    EXPECT_EQ(4, rb.getSize());
+    EXPECT_EQ(&rb[3], &grown);
+    EXPECT_EQ("two", grown.text);
+    EXPECT_EQ("two", rb.top().text);
+}
+
+TEST(RingBuffer, DoubleEnded)
+{
+    // random operations at both ends match std::deque
+    RingBuffer<int> rb(5);
+    std::deque<int> expected;
+    std::mt19937 generator(7);
+    for(int i = 0; i < 1000; ++i)
+    {
+        const unsigned int operation = generator() % 4;
+        if(operation == 0 && expected.size() < 5)
+        {
+            rb.push(i);
+            expected.push_back(i);
+        }
+        else if(operation == 1 && expected.size() < 5)
+        {
+            EXPECT_EQ(i, rb.emplace_front(i));
+            expected.push_front(i);
+        }
+        else if(operation == 2 && !expected.empty())
+        {
+            rb.pop();
+            expected.pop_front();
+        }
+        else if(operation == 3 && !expected.empty())
+        {
+            rb.pop_back();
+            expected.pop_back();
+        }
+
+        ASSERT_EQ(expected.size(), rb.getSize());
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), rb.begin()));
+        if(!expected.empty())
+        {
+            EXPECT_EQ(expected.front(), rb.top());
+            EXPECT_EQ(expected.back(), rb.back());
+        }
+    }
+
+    rb.clear();
+    bool exceptionThrown = false;
+    try
+    {
+        rb.pop_back();
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+
+    // a full buffer throws, or overwrites the newest element
+    for(int i = 0; i < 5; ++i)
+    {
+        rb.push(i);
+    }
+    exceptionThrown = false;
+    try
+    {
+        rb.push_front(-1);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+
+    rb.setOverwritePolicy(true);
+    EXPECT_TRUE(rb.push_front(-1));
+    EXPECT_EQ(5, rb.getSize());
+    EXPECT_EQ(-1, rb.top());
+    EXPECT_EQ(3, rb.back());
+    EXPECT_TRUE(rb.push_front(rb.back()));
+    EXPECT_EQ(3, rb.top());
+    EXPECT_EQ(2, rb.back());
+
+    // or grows
+    rb.setGrowthPolicy();
+    EXPECT_FALSE(rb.push_front(-2));
+    EXPECT_EQ(10, rb.getCapacity());
+    std::vector<int> contents(rb.begin(), rb.end());
+    EXPECT_EQ((std::vector<int>{-2, 3, -1, 0, 1, 2}), contents);
+}
+
+TEST(RingBuffer, TryPushPop)
+{
+    RingBuffer<std::string> rb(2);
+    std::string out = "unchanged";
+    EXPECT_FALSE(rb.try_pop(out));
+    EXPECT_EQ("unchanged", out);
+
+    const std::string first = "first";
+    EXPECT_TRUE(rb.try_push(first));
+    EXPECT_TRUE(rb.try_emplace(3, 'x'));
+    EXPECT_FALSE(rb.try_push("third"));
+    EXPECT_FALSE(rb.try_emplace("third"));
+    EXPECT_EQ(2, rb.getSize());
+
+    EXPECT_TRUE(rb.try_pop(out));
+    EXPECT_EQ("first", out);
+    EXPECT_EQ("xxx", rb.top());
+
+    // the policies decide whether a full buffer can be pushed to
+    EXPECT_TRUE(rb.try_push("second"));
+    rb.setOverwritePolicy(true);
+    EXPECT_TRUE(rb.try_push("third"));
+    EXPECT_EQ("second", rb.top());
+    rb.setOverwritePolicy(false);
+    rb.setGrowthPolicy();
+    EXPECT_TRUE(rb.try_push("fourth"));
+    EXPECT_EQ(4, rb.getCapacity());
+
+    RingBuffer<int> zero(0);
+    EXPECT_FALSE(zero.try_push(1));
+    zero.setOverwritePolicy(true);
+    EXPECT_FALSE(zero.try_push(1));
+}
+
+TEST(RingBuffer, growthPolicy)
+{
+    RingBuffer<std::string> rb(0);
+    EXPECT_EQ(0, rb.setGrowthPolicy());
+    EXPECT_EQ(2, rb.getGrowthPolicy());
+
+    // growth takes precedence over overwriting
+    rb.setOverwritePolicy(true);
+    std::vector<std::size_t> capacities;
+    for(int i = 0; i < 20; ++i)
+    {
+        EXPECT_FALSE(rb.push(std::to_string(i)));
+        if(capacities.empty() || capacities.back() != rb.getCapacity())
+        {
+            capacities.push_back(rb.getCapacity());
+        }
+    }
+    EXPECT_EQ((std::vector<std::size_t>{1, 2, 4, 8, 16, 32}), capacities);
+    for(std::size_t i = 0; i < 20; ++i)
+    {
+        EXPECT_EQ(std::to_string(i), rb[i]);
+    }
+
+    // growing across the wrap point, pushing an element of the RingBuffer
+    RingBuffer<std::string> wrapped(4);
+    wrapped.setGrowthPolicy(1.5);
+    wrapped.push("x");
+    wrapped.push("x");
+    wrapped.pop();
+    wrapped.pop();
+    for(int i = 0; i < 4; ++i)
+    {
+        wrapped.push(std::to_string(i));
+    }
+    wrapped.push(wrapped.top());
+    EXPECT_EQ(6, wrapped.getCapacity());
+    EXPECT_EQ(5, wrapped.getSize());
+    EXPECT_EQ("0", wrapped[0]);
+    EXPECT_EQ("3", wrapped[3]);
+    EXPECT_EQ("0", wrapped[4]);
+
+    // a range grows to fit at once
+    std::vector<std::string> range(20, "r");
+    wrapped.push(range.begin(), range.end());
+    EXPECT_EQ(25, wrapped.getCapacity());
+    EXPECT_EQ(25, wrapped.getSize());
+    EXPECT_EQ("0", wrapped.top());
+
+    // turning it off throws again
+    EXPECT_EQ(1.5, wrapped.setGrowthPolicy(0));
+    bool exceptionThrown = false;
+    try
+    {
+        wrapped.push("full");
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+}
+
+TEST(RingBuffer, shrinkPolicy)
+{
+    RingBuffer<int> rb(64);
+    rb.setGrowthPolicy();
+    EXPECT_EQ(0, rb.setShrinkPolicy(0.25));
+    EXPECT_EQ(0.25, rb.getShrinkPolicy());
+
+    for(int i = 0; i < 64; ++i)
+    {
+        rb.push(i);
+    }
+    for(int i = 0; i < 48; ++i)
+    {
+        rb.pop();
+    }
+    EXPECT_EQ(64, rb.getCapacity());
+
+    // below a quarter full, the capacity becomes twice the size
+    rb.pop();
+    EXPECT_EQ(30, rb.getCapacity());
+    EXPECT_EQ(15, rb.getSize());
+    EXPECT_EQ(49, rb.top());
+
+    rb.discard(10);
+    EXPECT_EQ(10, rb.getCapacity());
+    EXPECT_EQ(59, rb.top());
+
+    std::vector<int> out;
+    rb.pop_into(std::back_inserter(out), 5);
+    EXPECT_EQ(1, rb.getCapacity());
+    EXPECT_TRUE(rb.empty());
+    EXPECT_EQ(63, out.back());
+
+    // and grows back on the next burst
+    for(int i = 0; i < 100; ++i)
+    {
+        rb.push(i);
+    }
+    EXPECT_EQ(128, rb.getCapacity());
+
+    // copies keep the policies
+    RingBuffer<int> copy(rb);
+    EXPECT_EQ(2, copy.getGrowthPolicy());
+    EXPECT_EQ(0.25, copy.getShrinkPolicy());
+}
+
+TEST(RingBuffer, shrinkPolicyNeedsGrowth)
+{
+    // a fixed capacity is kept, or the next burst would not fit
+    RingBuffer<int> rb(64);
+    rb.setShrinkPolicy(0.25);
+    for(int i = 0; i < 64; ++i)
+    {
+        rb.push(i);
+    }
+    rb.discard(60);
+    EXPECT_EQ(64, rb.getCapacity());
+    for(int i = 0; i < 60; ++i)
+    {
+        rb.push(i);
+    }
+    EXPECT_EQ(64, rb.getSize());
+
+    // shrinks once growth is set
+    rb.setGrowthPolicy();
+    rb.discard(60);
+    EXPECT_EQ(8, rb.getCapacity());
+}
+
+TEST(RingBuffer, UninitializedStorage)
+{
+    {
+        // no default constructor needed, and nothing constructed up front
+        RingBuffer<NoDefault> rb(4);
+        rb.push(NoDefault(1));
+        rb.push(NoDefault(2));
+        EXPECT_EQ(1, rb.top().value);
+        rb.changeCapacity(8);
+        EXPECT_EQ(2, rb.at(1).value);
+        rb.changeSize(5, NoDefault(3));
+        EXPECT_EQ(3, rb.at(4).value);
+    }
+
+    auto shared = std::make_shared<int>(1);
+    {
+        RingBuffer<std::shared_ptr<int>> rb(4);
+        for(unsigned int i = 0; i < 3; ++i)
+        {
+            rb.push(shared);
+        }
+        EXPECT_EQ(4, shared.use_count());
+
+        // popping destroys right away
+        rb.pop();
+        EXPECT_EQ(3, shared.use_count());
+
+        rb.push(shared);
+        rb.push(shared);
+        EXPECT_EQ(5, shared.use_count());
+
+        // truncating destroys the truncated elements
+        rb.changeSize(3);
+        EXPECT_EQ(4, shared.use_count());
+        rb.setResizePolicy(false);
+        rb.changeSize(2);
+        EXPECT_EQ(3, shared.use_count());
+        rb.changeCapacity(1);
+        EXPECT_EQ(2, shared.use_count());
+        rb.changeCapacity(6);
+        EXPECT_EQ(2, shared.use_count());
+
+        {
+            RingBuffer<std::shared_ptr<int>> copy(rb);
+            EXPECT_EQ(3, shared.use_count());
+            copy = rb;
+            EXPECT_EQ(3, shared.use_count());
+
+            RingBuffer<std::shared_ptr<int>> moved(std::move(copy));
+            EXPECT_EQ(3, shared.use_count());
+            EXPECT_EQ(0, copy.getCapacity());
+            EXPECT_TRUE(copy.empty());
+
+            moved = std::move(rb);
+            EXPECT_EQ(2, shared.use_count());
+            EXPECT_EQ(1, moved.getSize());
+            EXPECT_EQ(6, moved.getCapacity());
+
+            rb = moved;
+            EXPECT_EQ(3, shared.use_count());
+        }
+        EXPECT_EQ(2, shared.use_count());
+
+        rb.clear();
+        EXPECT_EQ(1, shared.use_count());
+        EXPECT_TRUE(rb.empty());
+        EXPECT_EQ(6, rb.getCapacity());
+
+        for(unsigned int i = 0; i < 6; ++i)
+        {
+            rb.push(shared);
+        }
+        EXPECT_EQ(7, shared.use_count());
+    }
+    EXPECT_EQ(1, shared.use_count());
+}
+
+namespace
+{
+
+// counts the elements it has outstanding, equal only to copies with the same id
+template <typename T, bool Propagate>
+struct TrackingAllocator
+{
+    typedef T value_type;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_copy_assignment;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_move_assignment;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_swap;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef TrackingAllocator<U, Propagate> other;
+    };
+
+    TrackingAllocator(int id, std::shared_ptr<long> outstanding) :
+    id(id),
+    outstanding(outstanding)
+    {}
+
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U, Propagate>& other) :
+    id(other.id),
+    outstanding(other.outstanding)
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        *outstanding += n;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        *outstanding -= n;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator ==(const TrackingAllocator& other) const
+    {
+        return id == other.id;
+    }
+
+    bool operator !=(const TrackingAllocator& other) const
+    {
+        return id != other.id;
+    }
+
+    int id;
+    std::shared_ptr<long> outstanding;
+};
+
+} // namespace
+
+TEST(RingBuffer, Allocator)
+{
+    auto outstandingA = std::make_shared<long>(0);
+    auto outstandingB = std::make_shared<long>(0);
+
+    {
+        typedef TrackingAllocator<int, true> Alloc;
+        RingBuffer<int, Alloc> a(8, Alloc(1, outstandingA));
+        EXPECT_EQ(8, *outstandingA);
+        EXPECT_EQ(1, a.get_allocator().id);
+
+        for(int i = 0; i < 5; ++i)
+        {
+            a.push(i);
+        }
+        a.changeCapacity(16);
+        EXPECT_EQ(16, *outstandingA);
+
+        RingBuffer<int, Alloc> b(4, Alloc(2, outstandingB));
+        EXPECT_EQ(4, *outstandingB);
+
+        // propagating copy assignment takes the other allocator
+        b = a;
+        EXPECT_EQ(1, b.get_allocator().id);
+        EXPECT_EQ(0, *outstandingB);
+        EXPECT_EQ(32, *outstandingA);
+        EXPECT_EQ(5, b.getSize());
+
+        RingBuffer<int, Alloc> c(4, Alloc(2, outstandingB));
+        c.swap(a);
+        EXPECT_EQ(2, a.get_allocator().id);
+        EXPECT_EQ(1, c.get_allocator().id);
+        EXPECT_EQ(4, a.getCapacity());
+        EXPECT_EQ(5, c.getSize());
+
+        // propagating move assignment steals the memory
+        a = std::move(c);
+        EXPECT_EQ(1, a.get_allocator().id);
+        EXPECT_EQ(0, *outstandingB);
+        for(int i = 0; i < 5; ++i)
+        {
+            EXPECT_EQ(i, a.at(i));
+        }
+
+        // "n + iterator" works for RingBuffers with an allocator
+        EXPECT_EQ(3, *(3 + a.begin()));
+    }
+    EXPECT_EQ(0, *outstandingA);
+    EXPECT_EQ(0, *outstandingB);
+
+    {
+        typedef TrackingAllocator<int, false> Alloc;
+        RingBuffer<int, Alloc> a(8, Alloc(1, outstandingA));
+        RingBuffer<int, Alloc> b(4, Alloc(2, outstandingB));
+        for(int i = 0; i < 5; ++i)
+        {
+            a.push(i);
+        }
+
+        // non propagating copy assignment keeps its own allocator
+        b = a;
+        EXPECT_EQ(2, b.get_allocator().id);
+        EXPECT_EQ(8, *outstandingA);
+        EXPECT_EQ(8, *outstandingB);
+        EXPECT_EQ(5, b.getSize());
+
+        // unequal allocators that don't propagate move element by element
+        RingBuffer<int, Alloc> c(4, Alloc(2, outstandingB));
+        c = std::move(a);
+        EXPECT_EQ(2, c.get_allocator().id);
+        EXPECT_EQ(16, *outstandingB);
+        EXPECT_EQ(8, *outstandingA);
+        EXPECT_TRUE(a.empty());
+        for(int i = 0; i < 5; ++i)
+        {
+            EXPECT_EQ(i, c.at(i));
+        }
+
+        RingBuffer<int, Alloc> d(c);
+        EXPECT_EQ(2, d.get_allocator().id);
+        EXPECT_EQ(24, *outstandingB);
+    }
+    EXPECT_EQ(0, *outstandingA);
+    EXPECT_EQ(0, *outstandingB);
+
+    // so std::vector moves RingBuffers when it reallocates instead of copying
+    static_assert(std::is_nothrow_move_constructible<RingBuffer<int>>::value, "");
+    static_assert(std::is_nothrow_move_assignable<RingBuffer<int>>::value, "");
+    static_assert(noexcept(std::declval<RingBuffer<int>&>().swap(std::declval<RingBuffer<int>&>())), "");
+    static_assert(std::is_nothrow_move_constructible<RingBuffer<int, TrackingAllocator<int, false>>>::value, "");
+    static_assert(std::is_nothrow_move_assignable<RingBuffer<int, TrackingAllocator<int, true>>>::value, "");
+    // may have to move element by element
+    static_assert(!std::is_nothrow_move_assignable<RingBuffer<int, TrackingAllocator<int, false>>>::value, "");
+}
+
+TEST(RingBuffer, BulkPushPop)
+{
+    {
+        // trivially copyable, pointer ranges use memcpy
+        RingBuffer<int> rb(8);
+        const int values[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        rb.push(values, values + 3);
+        rb.discard(3);
+        EXPECT_TRUE(rb.empty());
+
+        // wraps around the end of the buffer
+        EXPECT_EQ(0, rb.push(values, values + 7));
+        EXPECT_EQ(7, rb.getSize());
+        for(unsigned int i = 0; i < 7; ++i)
+        {
+            EXPECT_EQ((int)i, rb.at(i));
+        }
+
+        bool exceptionThrown = false;
+        try
+        {
+            rb.push(values, values + 2);
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+        EXPECT_EQ(7, rb.getSize());
+
+        int out[10] = {};
+        EXPECT_EQ(out + 6, rb.pop_into(out, 6));
+        for(int i = 0; i < 6; ++i)
+        {
+            EXPECT_EQ(i, out[i]);
+        }
+        EXPECT_EQ(1, rb.getSize());
+        EXPECT_EQ(6, rb.top());
+
+        exceptionThrown = false;
+        try
+        {
+            rb.pop_into(out, 2);
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+
+        rb.pop_into(out, 1);
+        EXPECT_TRUE(rb.empty());
+        EXPECT_EQ(out, rb.pop_into(out, 0));
+    }
+
+    {
+        // non trivial elements and non pointer iterators
+        RingBuffer<std::string> rb(5);
+        rb.push("x");
+        rb.push("y");
+        rb.pop();
+        rb.pop();
+
+        std::list<std::string> input{"a", "b", "c", "d"};
+        rb.push(input.begin(), input.end());
+        EXPECT_EQ(4, rb.getSize());
+        EXPECT_EQ("a", rb.top());
+        EXPECT_EQ("d", rb.at(3));
+
+        rb.discard(1);
+        EXPECT_EQ("b", rb.top());
+
+        std::vector<std::string> output;
+        rb.pop_into(std::back_inserter(output), 3);
+        EXPECT_TRUE(rb.empty());
+        ASSERT_EQ(3, output.size());
+        EXPECT_EQ("b", output[0]);
+        EXPECT_EQ("d", output[2]);
+    }
+
+    {
+        // input iterators are pushed one at a time
+        RingBuffer<int> rb(4);
+        std::istringstream stream("1 2 3");
+        rb.push(std::istream_iterator<int>(stream), std::istream_iterator<int>());
+        EXPECT_EQ(3, rb.getSize());
+        EXPECT_EQ(3, rb.at(2));
+
+        // and may be partially pushed when they don't fit
+        std::istringstream longer("4 5 6");
+        bool exceptionThrown = false;
+        try
+        {
+            rb.push(std::istream_iterator<int>(longer), std::istream_iterator<int>());
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+        EXPECT_EQ(4, rb.getSize());
+        EXPECT_EQ(4, rb.at(3));
+    }
+
+    {
+        // overwrite policy drops the oldest to make room
+        RingBuffer<int> rb(4);
+        rb.setOverwritePolicy(true);
+        const int values[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        rb.push(values, values + 3);
+        EXPECT_EQ(1, rb.push(values + 3, values + 5));
+        EXPECT_EQ(4, rb.getSize());
+        EXPECT_EQ(1, rb.top());
+
+        // longer than the capacity keeps the end of the range
+        EXPECT_EQ(8, rb.push(values, values + 8));
+        for(unsigned int i = 0; i < 4; ++i)
+        {
+            EXPECT_EQ(4 + (int)i, rb.at(i));
+        }
+
+        std::vector<int> vec(values, values + 6);
+        EXPECT_EQ(6, rb.push(vec.begin(), vec.end()));
+        EXPECT_EQ(2, rb.top());
+    }
+}
+
+TEST(RingBuffer, Spans)
+{
+    RingBuffer<int> rb(8);
+
+    {
+        auto read = rb.readSpans();
+        EXPECT_EQ(0, read[0].size + read[1].size);
+
+        auto write = rb.writeSpans();
+        EXPECT_EQ(8, write[0].size + write[1].size);
+    }
+
+    for(int i = 0; i < 6; ++i)
+    {
+        rb.push(i);
+    }
+    rb.discard(4);
+
+    {
+        // r = 4, w = 6
+        auto read = rb.readSpans();
+        ASSERT_EQ(2, read[0].size);
+        EXPECT_EQ(0, read[1].size);
+        EXPECT_EQ(4, read[0].data[0]);
+        EXPECT_EQ(5, read[0].data[1]);
+
+        // free space wraps around the end
+        auto write = rb.writeSpans();
+        ASSERT_EQ(2, write[0].size);
+        ASSERT_EQ(4, write[1].size);
+        for(int i = 0; i < 2; ++i)
+        {
+            write[0].data[i] = 6 + i;
+        }
+        for(int i = 0; i < 3; ++i)
+        {
+            write[1].data[i] = 8 + i;
+        }
+        rb.commit(5);
+    }
+
+    EXPECT_EQ(7, rb.getSize());
+    for(unsigned int i = 0; i < 7; ++i)
+    {
+        EXPECT_EQ(4 + (int)i, rb.at(i));
+    }
+
+    {
+        const RingBuffer<int>& constRef = rb;
+        auto read = constRef.readSpans();
+        ASSERT_EQ(4, read[0].size);
+        ASSERT_EQ(3, read[1].size);
+        EXPECT_EQ(4, read[0].data[0]);
+        EXPECT_EQ(8, read[1].data[0]);
+
+        auto write = rb.writeSpans();
+        ASSERT_EQ(1, write[0].size);
+        EXPECT_EQ(0, write[1].size);
+        write[0].data[0] = 11;
+        rb.commit(1);
+    }
+
+    {
+        // full
+        auto write = rb.writeSpans();
+        EXPECT_EQ(0, write[0].size + write[1].size);
+
+        auto read = rb.readSpans();
+        EXPECT_EQ(8, read[0].size + read[1].size);
+
+        bool exceptionThrown = false;
+        try
+        {
+            rb.commit(1);
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+    }
+
+    rb.discard(8);
+    EXPECT_TRUE(rb.empty());
+}
+
+TEST(RingBuffer, Claim)
+{
+    RingBuffer<std::string> rb(4);
+    rb.push("a");
+    rb.push("b");
+    rb.push("c");
+    rb.pop();
+    rb.pop();
+
+    // exactly n slots, built in place
+    auto claimed = rb.claim(2);
+    ASSERT_EQ(1, claimed[0].size);
+    ASSERT_EQ(1, claimed[1].size);
+    new (claimed[0].data) std::string("d");
+    new (claimed[1].data) std::string("e");
+    rb.commit(2);
+    EXPECT_EQ(3, rb.getSize());
+    EXPECT_EQ("e", rb.back());
+
+    bool exceptionThrown = false;
+    try
+    {
+        rb.claim(2);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+
+    // the growth policy makes room instead
+    rb.setGrowthPolicy();
+    claimed = rb.claim(6);
+    EXPECT_EQ(9, rb.getCapacity());
+    EXPECT_EQ(6, claimed[0].size + claimed[1].size);
+    EXPECT_EQ(0, rb.claim(0)[0].size);
+}
+
+TEST(RingBuffer, IteratorArithmeticAcrossWrap)
+{
+    RingBuffer<int> rb(10);
+    for(int i = 0; i < 6; ++i)
+    {
+        rb.push(-1);
+    }
+    rb.discard(6);
+
+    // r = 6, elements wrap around the end of the buffer
+    for(int i = 0; i < 9; ++i)
+    {
+        rb.push(8 - i);
+    }
+
+    {
+        auto begin = rb.begin();
+        auto end = rb.end();
+        EXPECT_EQ(9, end - begin);
+        EXPECT_EQ(-9, begin - end);
+
+        // both sides of the wrap point
+        auto beforeWrap = begin + 3;
+        auto afterWrap = begin + 5;
+        EXPECT_TRUE(beforeWrap < afterWrap);
+        EXPECT_FALSE(afterWrap < beforeWrap);
+        EXPECT_TRUE(afterWrap < end);
+        EXPECT_EQ(2, afterWrap - beforeWrap);
+        EXPECT_EQ(-2, beforeWrap - afterWrap);
+        EXPECT_EQ(3, afterWrap[0]);
+        EXPECT_EQ(beforeWrap, afterWrap - 2);
+        EXPECT_EQ(end, afterWrap + 4);
+        EXPECT_EQ(0, *(end - 1));
+    }
+
+    std::sort(rb.begin(), rb.end());
+    for(unsigned int i = 0; i < 9; ++i)
+    {
+        EXPECT_EQ((int)i, rb.at(i));
+    }
+    EXPECT_EQ(4, std::lower_bound(rb.cbegin(), rb.cend(), 4) - rb.cbegin());
+
+    {
+        // full buffer, r == w
+        rb.push(9);
+        auto begin = rb.begin();
+        EXPECT_EQ(10, rb.end() - begin);
+        EXPECT_EQ(rb.end(), begin + 10);
+        EXPECT_EQ(9, begin[9]);
+        EXPECT_TRUE(begin + 9 < rb.end());
+    }
+}
+
+TEST(RingBuffer, IteratorJumpsMatchAt)
+{
+    static_assert(std::is_same<std::random_access_iterator_tag,
+        std::iterator_traits<RingBuffer<int>::Iterator<false>>::iterator_category>::value, "");
+    static_assert(std::is_same<std::random_access_iterator_tag,
+        std::iterator_traits<RingBuffer<int>::Iterator<true>>::iterator_category>::value, "");
+
+    // full and partly full, both starting past the middle of the storage
+    for(int size : {37, 30})
+    {
+        RingBuffer<int> rb(37);
+        for(int i = 0; i < 25; ++i)
+        {
+            rb.push(-1);
+        }
+        rb.discard(25);
+        for(int i = 0; i < size; ++i)
+        {
+            rb.push(i * 3);
+        }
+
+        // every jump, forwards and backwards, against at()
+        bool matches = true;
+        for(int i = 0; i <= size; ++i)
+        {
+            const RingBuffer<int>::Iterator<true> from = rb.cbegin() + i;
+            for(int j = 0; j <= size; ++j)
+            {
+                RingBuffer<int>::Iterator<true> to = from;
+                to += j - i;
+                matches = matches && to == rb.cbegin() + j
+                    && to - from == j - i
+                    && (to < from) == (j < i);
+                if(j < size)
+                {
+                    matches = matches && *to == rb.at(j) && from[j - i] == rb.at(j);
+                }
+                to -= j - i;
+                matches = matches && to == from;
+            }
+        }
+        EXPECT_TRUE(matches) << "size " << size;
+        EXPECT_EQ(size, rb.cend() - rb.cbegin());
+
+        // binary search relies on that arithmetic
+        bool allFound = true;
+        for(int i = 0; i < size; ++i)
+        {
+            auto found = std::lower_bound(rb.cbegin(), rb.cend(), i * 3);
+            allFound = allFound && found - rb.cbegin() == i;
+        }
+        EXPECT_TRUE(allFound) << "size " << size;
+    }
+}
+
+TEST(RingBuffer, IteratorIsSlim)
+{
+    typedef RingBuffer<int>::Iterator<false> Iter;
+    typedef RingBuffer<int>::Iterator<true> ConstIter;
+    EXPECT_TRUE(std::is_trivially_copyable<Iter>::value);
+    EXPECT_TRUE(std::is_trivially_copyable<ConstIter>::value);
+    EXPECT_EQ(2 * sizeof(void*), sizeof(Iter));
+    EXPECT_EQ(2 * sizeof(void*), sizeof(ConstIter));
+
+    // end() is the position past the last element, pushing moves it
+    RingBuffer<int> rb(4);
+    EXPECT_EQ(rb.begin(), rb.end());
+    rb.push(1);
+    auto it = rb.begin();
+    ++it;
+    EXPECT_EQ(rb.end(), it);
+    rb.push(2);
+    EXPECT_NE(rb.end(), it);
+    EXPECT_EQ(2, *it);
+}
@@ -0,0 +1,253 @@
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include <RB/SPSCRingBuffer.hpp>
+
+using namespace RB;
+
+TEST(SPSCRingBuffer, PopPush)
+{
+    SPSCRingBuffer<int> rb(5);
+    EXPECT_EQ(5, rb.getCapacity());
+    EXPECT_TRUE(rb.empty());
+
+    for(int j = 0; j < 3; ++j)
+    {
+        for(int i = 0; i < 5; ++i)
+        {
+            rb.push(i);
+            EXPECT_EQ(i + 1, rb.getSize());
+        }
+
+        bool exceptionThrown = false;
+        try
+        {
+            rb.push(5);
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+        EXPECT_FALSE(rb.try_push(5));
+
+        for(int i = 0; i < 5; ++i)
+        {
+            EXPECT_EQ(i, rb.top());
+            rb.pop();
+        }
+        EXPECT_TRUE(rb.empty());
+
+        exceptionThrown = false;
+        try
+        {
+            rb.pop();
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+
+        int value = -1;
+        EXPECT_FALSE(rb.try_pop(value));
+        EXPECT_EQ(-1, value);
+
+        // offset the indices for the next round
+        rb.push(0);
+        rb.push(1);
+        EXPECT_TRUE(rb.try_pop(value));
+        EXPECT_EQ(0, value);
+        EXPECT_TRUE(rb.try_pop(value));
+        EXPECT_EQ(1, value);
+    }
+}
+
+TEST(SPSCRingBuffer, ZeroCapacity)
+{
+    SPSCRingBuffer<int> rb(0);
+    EXPECT_EQ(0, rb.getCapacity());
+    EXPECT_TRUE(rb.empty());
+    EXPECT_FALSE(rb.try_push(1));
+    EXPECT_EQ(0, rb.getSize());
+}
+
+TEST(SPSCRingBuffer, Threaded)
+{
+    const unsigned int count = 1000000;
+    SPSCRingBuffer<unsigned int> rb(64);
+
+    std::thread producer([&rb, count] () {
+        for(unsigned int i = 0; i < count; ++i)
+        {
+            while(!rb.try_push(i))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    bool inOrder = true;
+    unsigned int value = 0;
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        while(!rb.try_pop(value))
+        {
+            std::this_thread::yield();
+        }
+        inOrder = inOrder && value == i;
+    }
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(rb.empty());
+}
+
+TEST(SPSCRingBuffer, Claim)
+{
+    SPSCRingBuffer<int> rb(6);
+    rb.push(-1);
+    rb.push(-1);
+    rb.push(-1);
+    rb.pop();
+    rb.pop();
+    rb.pop();
+
+    // r = w = 3, the 6 free slots wrap around the end of the 7 slot storage
+    auto write = rb.claim(10);
+    ASSERT_EQ(4, write[0].size);
+    ASSERT_EQ(2, write[1].size);
+    write = rb.claim(5);
+    ASSERT_EQ(4, write[0].size);
+    ASSERT_EQ(1, write[1].size);
+    for(int i = 0; i < 4; ++i)
+    {
+        write[0].data[i] = i;
+    }
+    write[1].data[0] = 4;
+    EXPECT_TRUE(rb.empty());
+    rb.commit(5);
+    EXPECT_EQ(5, rb.getSize());
+    EXPECT_EQ(1, rb.claim(10)[0].size + rb.claim(10)[1].size);
+
+    // elements are processed in place, then released
+    auto read = rb.readClaim(3);
+    ASSERT_EQ(3, read[0].size);
+    EXPECT_EQ(0, read[1].size);
+    read[0].data[2] *= 10;
+    rb.release(2);
+    EXPECT_EQ(20, rb.top());
+
+    read = rb.readClaim(10);
+    ASSERT_EQ(2, read[0].size);
+    ASSERT_EQ(1, read[1].size);
+    EXPECT_EQ(3, read[0].data[1]);
+    EXPECT_EQ(4, read[1].data[0]);
+
+    bool exceptionThrown = false;
+    try
+    {
+        rb.release(4);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+
+    exceptionThrown = false;
+    try
+    {
+        rb.commit(4);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+
+    rb.release(3);
+    EXPECT_TRUE(rb.empty());
+}
+
+TEST(SPSCRingBuffer, ThreadedClaim)
+{
+    const unsigned int count = 1000000;
+    SPSCRingBuffer<unsigned int> rb(64);
+
+    std::thread producer([&rb, count] () {
+        unsigned int next = 0;
+        while(next < count)
+        {
+            // write in batches of up to 16 straight into the slots
+            auto write = rb.claim(std::min(16u, count - next));
+            std::size_t claimed = 0;
+            for(auto& span : write)
+            {
+                for(std::size_t i = 0; i < span.size; ++i)
+                {
+                    span.data[i] = next++;
+                }
+                claimed += span.size;
+            }
+            if(claimed == 0)
+            {
+                std::this_thread::yield();
+            }
+            rb.commit(claimed);
+        }
+    });
+
+    bool inOrder = true;
+    unsigned int expected = 0;
+    while(expected < count)
+    {
+        auto read = rb.readClaim(32);
+        std::size_t claimed = 0;
+        for(auto& span : read)
+        {
+            for(std::size_t i = 0; i < span.size; ++i)
+            {
+                inOrder = inOrder && span.data[i] == expected++;
+            }
+            claimed += span.size;
+        }
+        if(claimed == 0)
+        {
+            std::this_thread::yield();
+        }
+        rb.release(claimed);
+    }
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(rb.empty());
+}
+
+TEST(SPSCRingBuffer, PopReleasesElement)
+{
+    SPSCRingBuffer<std::shared_ptr<int>> rb(4);
+    std::shared_ptr<int> value = std::make_shared<int>(1);
+
+    rb.push(value);
+    rb.push(value);
+    rb.push(value);
+    EXPECT_EQ(4, value.use_count());
+
+    rb.pop();
+    EXPECT_EQ(3, value.use_count());
+
+    std::shared_ptr<int> out;
+    EXPECT_TRUE(rb.try_pop(out));
+    EXPECT_EQ(3, value.use_count());
+    out.reset();
+    EXPECT_EQ(2, value.use_count());
+
+    rb.readClaim(1);
+    rb.release(1);
+    EXPECT_EQ(1, value.use_count());
+}
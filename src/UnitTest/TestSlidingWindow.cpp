@@ -0,0 +1,244 @@
+#include <stdexcept>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include <RB/SlidingWindow.hpp>
+
+using namespace RB;
+
+TEST(SlidingWindow, PushEvicts)
+{
+    SlidingWindow<int> window(3);
+    EXPECT_EQ(3, window.getWindowSize());
+    EXPECT_TRUE(window.empty());
+    EXPECT_EQ(0, window.getSum());
+    EXPECT_TRUE(std::isnan(window.getMean()));
+
+    EXPECT_FALSE(window.push(4));
+    EXPECT_FALSE(window.push(-2));
+    EXPECT_FALSE(window.push(7));
+    EXPECT_EQ(9, window.getSum());
+    EXPECT_DOUBLE_EQ(3.0, window.getMean());
+    EXPECT_EQ(-2, window.getMin());
+    EXPECT_EQ(7, window.getMax());
+
+    // 4 leaves
+    EXPECT_TRUE(window.push(1));
+    EXPECT_EQ(3, window.getSize());
+    EXPECT_EQ(6, window.getSum());
+    EXPECT_EQ(-2, window.getMin());
+    EXPECT_EQ(7, window.getMax());
+
+    // -2 leaves
+    EXPECT_TRUE(window.push(1));
+    EXPECT_EQ(1, window.getMin());
+    EXPECT_EQ(7, window.getMax());
+
+    window.pop();
+    EXPECT_EQ(2, window.getSize());
+    EXPECT_EQ(2, window.getSum());
+    EXPECT_EQ(1, window.getMin());
+    EXPECT_EQ(1, window.getMax());
+    EXPECT_EQ(1, window.getSamples()[0]);
+
+    window.clear();
+    EXPECT_TRUE(window.empty());
+    EXPECT_FALSE(window.push(5));
+    EXPECT_EQ(5, window.getMin());
+    EXPECT_EQ(5, window.getMax());
+
+    window.pop();
+    bool exceptionThrown = false;
+    try
+    {
+        window.pop();
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+
+    SlidingWindow<int> zero(0);
+    exceptionThrown = false;
+    try
+    {
+        zero.push(1);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+}
+
+TEST(SlidingWindow, MatchesRecomputing)
+{
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> values(-50, 50);
+    std::uniform_int_distribution<int> actions(0, 9);
+
+    for(std::size_t windowSize : {1, 2, 5, 37})
+    {
+        SlidingWindow<std::int64_t> window(windowSize);
+        bool matches = true;
+        for(int i = 0; i < 2000; ++i)
+        {
+            // mostly pushes, with runs of equal values and some pops
+            if(actions(generator) == 0 && !window.empty())
+            {
+                window.pop();
+            }
+            else
+            {
+                window.push(values(generator) / 10);
+            }
+            if(window.empty())
+            {
+                continue;
+            }
+
+            const RingBuffer<std::int64_t>& samples = window.getSamples();
+            std::int64_t sum = 0;
+            std::int64_t min = samples[0];
+            std::int64_t max = samples[0];
+            for(std::size_t j = 0; j < samples.getSize(); ++j)
+            {
+                sum += samples[j];
+                min = std::min(min, samples[j]);
+                max = std::max(max, samples[j]);
+            }
+            matches = matches && window.getSum() == sum
+                && window.getMin() == min && window.getMax() == max;
+        }
+        EXPECT_TRUE(matches) << "window size " << windowSize;
+    }
+}
+
+TEST(SlidingWindow, CompensatedSum)
+{
+    // a plain running sum loses the 1.0 added to 1e16
+    SlidingWindow<double> window(4);
+    window.push(1e16);
+    window.push(1.0);
+    window.push(-1e16);
+    window.push(1.0);
+    EXPECT_EQ(2.0, window.getSum());
+    EXPECT_EQ(0.5, window.getMean());
+
+    // and does not drift while a long stream passes through the window
+    std::mt19937 generator(11);
+    std::lognormal_distribution<double> values(0.0, 4.0);
+    SlidingWindow<double> rolling(100);
+    for(int i = 0; i < 100000; ++i)
+    {
+        rolling.push(values(generator) * (i % 2 == 0 ? 1.0 : -1.0));
+    }
+
+    long double exact = 0;
+    const RingBuffer<double>& samples = rolling.getSamples();
+    for(std::size_t j = 0; j < samples.getSize(); ++j)
+    {
+        exact += samples[j];
+    }
+    EXPECT_NEAR((double)exact, rolling.getSum(), 1e-9 * std::abs((double)exact) + 1e-9);
+}
+
+namespace
+{
+
+struct Maximum
+{
+    int operator ()(int a, int b) const
+    {
+        return std::max(a, b);
+    }
+};
+
+} // namespace
+
+TEST(SlidingAggregate, NonCommutative)
+{
+    // concatenation shows the samples are folded oldest first
+    SlidingAggregate<std::string, std::plus<std::string>> window(3);
+    EXPECT_EQ(3, window.getWindowSize());
+    EXPECT_TRUE(window.empty());
+
+    EXPECT_FALSE(window.push("a"));
+    EXPECT_EQ("a", window.get());
+    EXPECT_FALSE(window.push("b"));
+    EXPECT_FALSE(window.push("c"));
+    EXPECT_EQ("abc", window.get());
+    EXPECT_TRUE(window.push("d"));
+    EXPECT_EQ("bcd", window.get());
+    EXPECT_TRUE(window.push("e"));
+    EXPECT_EQ("cde", window.get());
+    window.pop();
+    EXPECT_EQ("de", window.get());
+    EXPECT_EQ(2, window.getSize());
+    EXPECT_FALSE(window.push("f"));
+    EXPECT_EQ("def", window.get());
+    EXPECT_TRUE(window.push("g"));
+    EXPECT_EQ("efg", window.get());
+    EXPECT_EQ("e", window.getSamples()[0]);
+
+    window.clear();
+    EXPECT_TRUE(window.empty());
+    window.push("x");
+    EXPECT_EQ("x", window.get());
+
+    window.pop();
+    bool exceptionThrown = false;
+    try
+    {
+        window.pop();
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+}
+
+TEST(SlidingAggregate, MatchesRecomputing)
+{
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int> values(-1000, 1000);
+    std::uniform_int_distribution<int> actions(0, 4);
+
+    for(std::size_t windowSize : {1, 2, 8, 33})
+    {
+        SlidingAggregate<int, Maximum> window(windowSize);
+        bool matches = true;
+        for(int i = 0; i < 2000; ++i)
+        {
+            if(actions(generator) == 0 && !window.empty())
+            {
+                window.pop();
+            }
+            else
+            {
+                window.push(values(generator));
+            }
+            if(window.empty())
+            {
+                continue;
+            }
+
+            const RingBuffer<int>& samples = window.getSamples();
+            int max = samples[0];
+            for(std::size_t j = 1; j < samples.getSize(); ++j)
+            {
+                max = std::max(max, samples[j]);
+            }
+            matches = matches && window.get() == max;
+        }
+        EXPECT_TRUE(matches) << "window size " << windowSize;
+    }
+}
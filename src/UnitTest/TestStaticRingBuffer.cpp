@@ -0,0 +1,213 @@
+#include <stdexcept>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+
+#include "gtest/gtest.h"
+
+#include <RB/StaticRingBuffer.hpp>
+
+using namespace RB;
+
+namespace
+{
+
+struct NoDefault
+{
+    NoDefault(int value) : value(value) {}
+    int value;
+};
+
+} // namespace
+
+TEST(StaticRingBuffer, PopPush)
+{
+    StaticRingBuffer<int, 5> rb;
+    EXPECT_EQ(5, rb.getCapacity());
+    EXPECT_TRUE(rb.empty());
+
+    for(int j = 0; j < 3; ++j)
+    {
+        for(int i = 0; i < 5; ++i)
+        {
+            EXPECT_FALSE(rb.push(i));
+            EXPECT_EQ(i + 1, rb.getSize());
+        }
+
+        bool exceptionThrown = false;
+        try
+        {
+            rb.push(5);
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+
+        for(int i = 0; i < 5; ++i)
+        {
+            EXPECT_EQ(i, rb.top());
+            rb.pop();
+        }
+        EXPECT_TRUE(rb.empty());
+
+        exceptionThrown = false;
+        try
+        {
+            rb.pop();
+        }
+        catch (const std::out_of_range& e)
+        {
+            exceptionThrown = true;
+        }
+        EXPECT_TRUE(exceptionThrown);
+
+        // offset the read index for the next round
+        rb.push(0);
+        rb.push(1);
+        rb.pop();
+        rb.pop();
+    }
+}
+
+TEST(StaticRingBuffer, Indexing)
+{
+    StaticRingBuffer<char, 4> rb;
+    rb.push('x');
+    rb.push('y');
+    rb.pop();
+    rb.pop();
+
+    for(char c = 'a'; c < 'e'; ++c)
+    {
+        rb.push(c);
+    }
+
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ('a' + i, rb[i]);
+        EXPECT_EQ('a' + i, rb.at(i));
+    }
+
+    bool exceptionThrown = false;
+    try
+    {
+        rb.at(4);
+    }
+    catch (const std::out_of_range& e)
+    {
+        exceptionThrown = true;
+    }
+    EXPECT_TRUE(exceptionThrown);
+}
+
+TEST(StaticRingBuffer, Iterator)
+{
+    StaticRingBuffer<int, 8> rb;
+    for(int i = 0; i < 5; ++i)
+    {
+        rb.push(0);
+        rb.pop();
+    }
+    for(int i = 0; i < 7; ++i)
+    {
+        rb.push(6 - i);
+    }
+
+    {
+        int expected = 6;
+        for(const int& value : rb)
+        {
+            EXPECT_EQ(expected--, value);
+        }
+    }
+
+    auto begin = rb.begin();
+    auto end = rb.end();
+    EXPECT_EQ(7, end - begin);
+    EXPECT_EQ(end, begin + 7);
+    EXPECT_EQ(end, 7 + begin);
+    EXPECT_EQ(3, begin[3]);
+    EXPECT_TRUE(begin < end);
+    EXPECT_EQ(0, *--end);
+
+    // random access iterators across the wrap point work with the algorithms
+    std::sort(rb.begin(), rb.end());
+    for(std::size_t i = 0; i < 7; ++i)
+    {
+        EXPECT_EQ((int)i, rb[i]);
+    }
+    EXPECT_TRUE(std::binary_search(rb.cbegin(), rb.cend(), 4));
+    EXPECT_EQ(5, std::lower_bound(rb.cbegin(), rb.cend(), 5) - rb.cbegin());
+
+    const StaticRingBuffer<int, 8>& constRef = rb;
+    EXPECT_TRUE(std::is_const<std::remove_reference_t<decltype(*constRef.begin())>>::value);
+}
+
+TEST(StaticRingBuffer, NoAllocationOrDefaultConstruction)
+{
+    StaticRingBuffer<NoDefault, 3> rb;
+    rb.push(NoDefault(1));
+    rb.push(NoDefault(2));
+    EXPECT_EQ(1, rb.top().value);
+    EXPECT_EQ(2, rb[1].value);
+
+    // storage is inline
+    EXPECT_GE(sizeof(rb), 3 * sizeof(NoDefault));
+    EXPECT_LE(sizeof(rb), 3 * sizeof(NoDefault) + 4 * sizeof(std::size_t));
+}
+
+TEST(StaticRingBuffer, Lifetime)
+{
+    auto shared = std::make_shared<int>(1);
+    {
+        StaticRingBuffer<std::shared_ptr<int>, 3> rb;
+        rb.push(shared);
+        rb.push(shared);
+        EXPECT_EQ(3, shared.use_count());
+
+        // popping destroys right away
+        rb.pop();
+        EXPECT_EQ(2, shared.use_count());
+
+        rb.push(shared);
+        rb.push(shared);
+        EXPECT_EQ(4, shared.use_count());
+
+        StaticRingBuffer<std::shared_ptr<int>, 3> copy(rb);
+        EXPECT_EQ(7, shared.use_count());
+
+        StaticRingBuffer<std::shared_ptr<int>, 3> moved(std::move(copy));
+        EXPECT_EQ(7, shared.use_count());
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(3, moved.getSize());
+
+        moved.clear();
+        EXPECT_EQ(4, shared.use_count());
+    }
+    EXPECT_EQ(1, shared.use_count());
+
+    // so std::vector moves StaticRingBuffers when it reallocates
+    static_assert(std::is_nothrow_move_constructible<StaticRingBuffer<std::shared_ptr<int>, 3>>::value, "");
+    static_assert(std::is_nothrow_move_assignable<StaticRingBuffer<std::shared_ptr<int>, 3>>::value, "");
+}
+
+TEST(StaticRingBuffer, overwritePolicy)
+{
+    StaticRingBuffer<int, 3> rb;
+    EXPECT_FALSE(rb.setOverwritePolicy(true));
+    EXPECT_TRUE(rb.getOverwritePolicy());
+
+    for(int i = 0; i < 3; ++i)
+    {
+        EXPECT_FALSE(rb.push(i));
+    }
+    for(int i = 3; i < 10; ++i)
+    {
+        EXPECT_TRUE(rb.push(i));
+        EXPECT_EQ(3, rb.getSize());
+        EXPECT_EQ(i - 2, rb.top());
+        EXPECT_EQ(i, rb[2]);
+    }
+}